@@ -1,9 +1,44 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdbool.h>
+#include <ctype.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#endif
 
 #define MAX_STRING 100
+#define LIKE_STRIPES 8 // Jumlah stripe counter like per post
+#define CACHE_LINE 64
+#define COLD_MARKER "~cold~" // Caption post cold di posts.txt format lama (tanpa kolom flag cold)
+#define POSTS_FORMAT 2 // Versi posts.txt: baris id|user_id|caption|media|likes|cold
+#define COLD_CACHE_BUCKETS 256
+#define COLD_CACHE_BYTES (1 << 20) // Batas memori cache blok cold (LRU)
+#define COLD_GROUP_BYTES 4096 // Target ukuran mentah satu blok terkompresi di cold.seg (beberapa post)
+#define RENDER_CACHE_BUCKETS 1024
+#define RENDER_CACHE_BYTES (1 << 20) // Batas default cache render post (--render-cache-kb)
+#define TAG_BUCKETS 1024
+#define TAG_MAX 50 // Panjang maksimum #tag / @user (tanpa prefix)
+#ifdef _WIN32
+#define NULL_DEVICE "NUL" // Sink output benchmark
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
 
 typedef struct User {
     int id;
@@ -13,19 +48,31 @@ typedef struct User {
     struct User *next;
 } User;
 
-typedef struct LikeNode {
-    int user_id;
-    struct LikeNode *next;
-} LikeNode;
+// Satu stripe set liker (dipilih dari hash user_id), dipad satu cache line dan dialokasikan rata
+// CACHE_LINE (mem_calloc_aligned) agar thread di stripe berbeda tidak saling berebut line.
+// Slot tabel: (user_id + 1) << 1 | active, 0 = kosong. Unlike hanya mematikan bit active sehingga
+// slot dipakai lagi saat user yang sama like ulang.
+typedef struct {
+    unsigned *slots; // Tabel open addressing (linear probing), kapasitas pangkat dua
+    int count; // Jumlah liker aktif di stripe ini
+    int lock;
+    int cap;
+    int used; // Slot terisi (aktif maupun nonaktif)
+    char pad[CACHE_LINE - sizeof(unsigned*) - 4 * sizeof(int)];
+} LikeStripe;
 
 typedef struct Post {
     int id;
     int user_id;
-    char content[MAX_STRING];
+    char *content; // Caption post hot (heap, seukuran teksnya); NULL selama cold
     char media[MAX_STRING];
-    int likes;
+    int likes; // Nilai dasar (dari file); total = likes + jumlah likeStripes
     struct Post *next;
-    LikeNode *likeList; // Tambahkan ini
+    LikeStripe *likeStripes; // Set liker ter-hash, dialokasikan saat like pertama
+    bool cold; // Caption & comment ada di segment cold, dimuat saat dibutuhkan
+    bool deleted; // Tombstone: sudah dihapus, menunggu direklamasi compactor
+    long deleted_seq; // Nomor aksi saat tombstone ditulis
+    unsigned rev; // Revisi tampilan, naik setiap like/unlike/edit/comment (validasi cache render)
 } Post;
 
 typedef struct Comment {
@@ -38,16 +85,59 @@ typedef struct Comment {
 
 // Stack for Undo (linked list)
 typedef struct UndoNode {
-    Post post;
+    Post post; // Salinan isi post (tanpa likeStripes)
+    Post *live; // Post ber-tombstone yang masih di list, NULL jika sudah direklamasi
     struct UndoNode *next;
 } UndoNode;
 
 // Queue for Notifications (linked list)
 typedef struct NotifNode {
     char msg[MAX_STRING * 2];
+    int post_id; // Post yang dirujuk (0 = tidak merujuk post)
     struct NotifNode *next;
 } NotifNode;
 
+// Entry index segment cold: blok terkompresi yang memuat post + posisi post di dalam blok
+typedef struct {
+    int post_id;
+    long offset;
+    int clen;
+    int rawlen;
+    int start; // Posisi data post di blok setelah dekompres
+    int len;
+} ColdIndexEntry;
+
+// Blok cold yang sudah didekompresi (disimpan di cache LRU)
+typedef struct ColdBlock {
+    int post_id;
+    char *raw; // Caption + baris comment
+    char *caption;
+    Comment *comments;
+    int comment_count;
+    size_t bytes;
+    struct ColdBlock *prev, *next; // Urutan LRU (head = paling baru dipakai)
+    struct ColdBlock *hnext; // Rantai bucket hash
+} ColdBlock;
+
+// Daftar post untuk satu #tag atau @user
+typedef struct TagEntry {
+    char tag[TAG_MAX + 2]; // Termasuk prefix '#' atau '@', huruf kecil
+    int *post_ids; // Terurut naik, tanpa duplikat
+    int count, capacity;
+    struct TagEntry *hnext; // Rantai bucket hash
+} TagEntry;
+
+// Blok tampilan post (header + comment) yang sudah dirender
+typedef struct RenderBlock {
+    int post_id;
+    unsigned rev; // Revisi post saat dirender; beda = basi
+    char *text;
+    size_t len;
+    size_t bytes;
+    struct RenderBlock *prev, *next; // Urutan LRU (head = paling baru dipakai)
+    struct RenderBlock *hnext; // Rantai bucket hash
+} RenderBlock;
+
 // Tambahkan struct BST untuk User
 typedef struct UserBSTNode {
     struct User *user;
@@ -76,8 +166,335 @@ typedef struct {
     // Tambahkan di AppState:
     UserBSTNode *userBST; // Tambahkan pointer ke root BST User
     CommentBSTNode *commentBST; // Tambahkan pointer ke root BST Comment
+
+    int last_comment_id;
+
+    // Tiered storage: index segment cold + cache LRU blok yang sudah dimuat
+    ColdIndexEntry *coldIndex;
+    int cold_count;
+    FILE *coldSeg;
+    char *coldGroup; // Blok cold terakhir yang didekompres (dipakai post bertetangga)
+    long cold_group_offset;
+    ColdBlock *coldBuckets[COLD_CACHE_BUCKETS];
+    ColdBlock *coldHead, *coldTail;
+    size_t cold_cache_bytes;
+
+    // Cache render post untuk view_posts (LRU dengan batas memori)
+    RenderBlock *renderBuckets[RENDER_CACHE_BUCKETS];
+    RenderBlock *renderHead, *renderTail;
+    size_t render_cache_bytes, render_cache_cap;
+    long render_hits, render_misses, render_evictions;
+
+    // Index #tag/@user -> post, dan sketch hashtag trending (dialokasikan saat tag pertama)
+    TagEntry *tagBuckets[TAG_BUCKETS];
+    int tag_count;
+    struct TrendSketch *trend;
+
+    // Tombstone & compactor inkremental (lihat compact_step)
+    int tombstones; // Post ber-tombstone yang belum direklamasi
+    int compact_phase;
+    bool compact_dirty; // Ada comment yang dibuang pada siklus ini (comments.txt perlu ditulis ulang)
+    bool compact_flush; // Abaikan masa grace: reklamasi semua tombstone (logout/exit/tool)
+    Post **compactPost;
+    Comment **compactComment;
+    NotifNode **compactNotif, *compactNotifPrev;
+    int *deadIds; // ID post yang sudah direklamasi, menunggu sweep comment & notifikasi
+    int dead_count, dead_capacity;
+    long reclaimed_bytes;
+    long action_seq; // Jumlah aksi menu (umur tombstone diukur dengan ini)
+
+    // Sharding berdasarkan user_id: ID post shard ini selalu = shard_index (mod shard_count)
+    int shard_index, shard_count;
+    bool in_memory; // Replica: store hanya di memori, save_* tidak menulis file
+
+    // Index ID post: array key terurut untuk lower bound. Post baru (ID terbesar) ditambahkan di ujung;
+    // dibangun ulang hanya jika urutan rusak (reklamasi, insert ID lama)
+    int *postIndexIds;
+    Post **postIndex;
+    int post_index_count, post_index_capacity;
+    bool post_index_valid;
 } AppState;
 
+// ======================= Memory Accounting =========================
+// Semua struktur yang hidup lama dialokasikan lewat fungsi mem_* sehingga jumlah objek
+// dan byte per jenis struktur selalu diketahui. Struktur berukuran tetap (node list/BST, stripe
+// like, dll.) memakai mem_alloc_sized/mem_free_sized: ukurannya sizeof di pemanggil, tanpa header.
+// Buffer berukuran variabel memakai mem_alloc/mem_free yang menyimpan ukuran di header kecil.
+// Array sementara (sort, view, heap) tetap memakai malloc biasa.
+
+enum {
+    MEM_USER, MEM_POST, MEM_CAPTION, MEM_COMMENT, MEM_LIKE_TABLE, MEM_LIKE_STRIPE, MEM_UNDO, MEM_NOTIF,
+    MEM_USER_BST, MEM_POST_BST, MEM_COMMENT_BST, MEM_POST_INDEX, MEM_COLD_INDEX,
+    MEM_COLD_CACHE, MEM_COMPACTOR, MEM_RENDER_CACHE, MEM_REPL_LOG, MEM_TAG_INDEX, MEM_TREND, MEM_TYPES
+};
+
+const char *mem_type_names[MEM_TYPES] = {
+    "User", "Post", "Post caption", "Comment", "LikeTable", "LikeStripe", "UndoNode", "NotifNode",
+    "UserBSTNode", "PostBSTNode", "CommentBSTNode", "Post ID index", "Cold index",
+    "Cold cache", "Compactor", "Render cache", "Change log", "Tag index", "Trending sketch"
+};
+
+long mem_bytes[MEM_TYPES];
+long mem_objects[MEM_TYPES];
+long mem_header_objects; // Alokasi hidup yang membawa MemHeader
+
+typedef union {
+    size_t size;
+    max_align_t align;
+} MemHeader;
+
+// [Memory] Catat perubahan byte & objek (atomic: like bisa dipanggil dari banyak thread)
+void mem_track(int type, long bytes, long objects) {
+    __atomic_fetch_add(&mem_bytes[type], bytes, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&mem_objects[type], objects, __ATOMIC_RELAXED);
+}
+
+// [Memory] malloc yang tercatat per jenis struktur
+void* mem_alloc(int type, size_t size) {
+    MemHeader *h = (MemHeader*)malloc(sizeof(MemHeader) + size);
+    if (!h) return NULL;
+    h->size = size;
+    mem_track(type, size, 1);
+    __atomic_fetch_add(&mem_header_objects, 1, __ATOMIC_RELAXED);
+    return h + 1;
+}
+
+// [Memory] calloc yang tercatat
+void* mem_calloc(int type, size_t size) {
+    void *ptr = mem_alloc(type, size);
+    if (ptr) memset(ptr, 0, size);
+    return ptr;
+}
+
+// [Memory] realloc yang tercatat (jumlah objek tidak berubah)
+void* mem_realloc(int type, void *ptr, size_t size) {
+    if (!ptr) return mem_alloc(type, size);
+    MemHeader *h = (MemHeader*)ptr - 1;
+    size_t old = h->size;
+    h = (MemHeader*)realloc(h, sizeof(MemHeader) + size);
+    if (!h) return NULL;
+    h->size = size;
+    mem_track(type, (long)size - (long)old, 0);
+    return h + 1;
+}
+
+// [Memory] free yang tercatat
+void mem_free(int type, void *ptr) {
+    if (!ptr) return;
+    MemHeader *h = (MemHeader*)ptr - 1;
+    mem_track(type, -(long)h->size, -1);
+    __atomic_fetch_sub(&mem_header_objects, 1, __ATOMIC_RELAXED);
+    free(h);
+}
+
+// [Memory] malloc tercatat tanpa header untuk struktur berukuran tetap (size = sizeof di pemanggil)
+void* mem_alloc_sized(int type, size_t size) {
+    void *ptr = malloc(size);
+    if (ptr) mem_track(type, size, 1);
+    return ptr;
+}
+
+// [Memory] calloc tercatat tanpa header
+void* mem_calloc_sized(int type, size_t size) {
+    void *ptr = calloc(1, size);
+    if (ptr) mem_track(type, size, 1);
+    return ptr;
+}
+
+// [Memory] free untuk blok dari mem_alloc_sized/mem_calloc_sized (size sama dengan saat alokasi)
+void mem_free_sized(int type, void *ptr, size_t size) {
+    if (!ptr) return;
+    mem_track(type, -(long)size, -1);
+    free(ptr);
+}
+
+// [Memory] calloc tercatat tanpa header yang rata CACHE_LINE (malloc hanya menjamin 16 byte)
+void* mem_calloc_aligned(int type, size_t size) {
+    void *ptr;
+#ifdef _WIN32
+    ptr = _aligned_malloc(size, CACHE_LINE);
+#else
+    if (posix_memalign(&ptr, CACHE_LINE, size) != 0) ptr = NULL;
+#endif
+    if (!ptr) return NULL;
+    memset(ptr, 0, size);
+    mem_track(type, size, 1);
+    return ptr;
+}
+
+// [Memory] free untuk blok dari mem_calloc_aligned
+void mem_free_aligned(int type, void *ptr, size_t size) {
+    if (!ptr) return;
+    mem_track(type, -(long)size, -1);
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+// [Memory] Ganti caption hot post dengan salinan seukuran teksnya (maks MAX_STRING - 1 karakter)
+void set_post_caption(Post *p, const char *text) {
+    if (p->content) mem_free_sized(MEM_CAPTION, p->content, strlen(p->content) + 1);
+    size_t n = strnlen(text, MAX_STRING - 1);
+    p->content = (char*)mem_alloc_sized(MEM_CAPTION, n + 1);
+    memcpy(p->content, text, n);
+    p->content[n] = '\0';
+}
+
+// [Memory] Lepas caption hot post (post menjadi cold / dibebaskan)
+void drop_post_caption(Post *p) {
+    if (p->content) mem_free_sized(MEM_CAPTION, p->content, strlen(p->content) + 1);
+    p->content = NULL;
+}
+
+// ======================= Like Counter (Concurrent) =========================
+// Like/unlike aman dipanggil dari banyak thread tanpa lock global:
+// - liker disimpan di set ter-hash per post: user_id memilih satu dari LIKE_STRIPES stripe, tiap
+//   stripe punya tabel open addressing sendiri yang dijaga spinlock kecil, jadi like/unlike O(1)
+//   dan thread yang me-like user berbeda jarang menyentuh stripe yang sama
+// - jumlah like = nilai dasar + jumlah count tiap stripe (dibaca tanpa lock)
+
+#define LIKE_TABLE_MIN 8
+
+// [Like] Hash user_id (multiplicative); bit atas memilih stripe, bit bawah memilih slot
+unsigned like_hash(unsigned key) {
+    return key * 2654435761u;
+}
+
+void like_lock(LikeStripe *s) {
+    while (__atomic_exchange_n(&s->lock, 1, __ATOMIC_ACQUIRE))
+        while (__atomic_load_n(&s->lock, __ATOMIC_RELAXED)) sched_yield();
+}
+
+void like_unlock(LikeStripe *s) {
+    __atomic_store_n(&s->lock, 0, __ATOMIC_RELEASE);
+}
+
+// [Like] Ambil (atau alokasikan sekali) array stripe milik post
+LikeStripe* post_like_stripes(Post *p) {
+    LikeStripe *stripes = __atomic_load_n(&p->likeStripes, __ATOMIC_ACQUIRE);
+    if (stripes) return stripes;
+    LikeStripe *fresh = (LikeStripe*)mem_calloc_aligned(MEM_LIKE_STRIPE, LIKE_STRIPES * sizeof(LikeStripe));
+    if (!fresh) return NULL;
+    if (__atomic_compare_exchange_n(&p->likeStripes, &stripes, fresh, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        return fresh;
+    mem_free_aligned(MEM_LIKE_STRIPE, fresh, LIKE_STRIPES * sizeof(LikeStripe)); // Thread lain lebih dulu memasang stripe
+    return stripes;
+}
+
+// [Like] Total like sebuah post (nilai dasar + seluruh stripe)
+int post_likes(const Post *p) {
+    long total = p->likes;
+    LikeStripe *stripes = __atomic_load_n(&p->likeStripes, __ATOMIC_ACQUIRE);
+    if (stripes)
+        for (int i = 0; i < LIKE_STRIPES; i++)
+            total += __atomic_load_n(&stripes[i].count, __ATOMIC_RELAXED);
+    return (int)total;
+}
+
+// [Like] Slot milik key pada stripe, atau slot kosong tempat menyisipkannya (lock harus dipegang)
+unsigned* like_slot(LikeStripe *s, unsigned key) {
+    unsigned mask = (unsigned)s->cap - 1;
+    for (unsigned i = like_hash(key) & mask;; i = (i + 1) & mask)
+        if (s->slots[i] == 0 || s->slots[i] >> 1 == key) return &s->slots[i];
+}
+
+// [Like] Gandakan tabel stripe saat load factor melewati 3/4 (lock harus dipegang)
+bool like_stripe_grow(LikeStripe *s) {
+    int old_cap = s->cap;
+    unsigned *old = s->slots;
+    unsigned *slots = (unsigned*)mem_calloc_sized(MEM_LIKE_TABLE, sizeof(unsigned) * (old_cap ? old_cap * 2 : LIKE_TABLE_MIN));
+    if (!slots) return false;
+    s->slots = slots;
+    s->cap = old_cap ? old_cap * 2 : LIKE_TABLE_MIN;
+    for (int i = 0; i < old_cap; i++)
+        if (old[i]) *like_slot(s, old[i] >> 1) = old[i];
+    mem_free_sized(MEM_LIKE_TABLE, old, sizeof(unsigned) * old_cap);
+    return true;
+}
+
+// [Like] Like post oleh user. Return 1 jika berhasil, 0 jika user sudah like
+int post_add_like(Post *p, int user_id) {
+    LikeStripe *stripes = post_like_stripes(p);
+    if (!stripes) return 0;
+    unsigned key = (unsigned)user_id + 1;
+    LikeStripe *s = &stripes[(like_hash(key) >> 16) % LIKE_STRIPES];
+    int added = 0;
+    like_lock(s);
+    if ((s->used + 1) * 4 <= s->cap * 3 || like_stripe_grow(s)) {
+        unsigned *slot = like_slot(s, key);
+        if (!(*slot & 1)) {
+            if (!*slot) s->used++;
+            *slot = key << 1 | 1;
+            __atomic_store_n(&s->count, s->count + 1, __ATOMIC_RELAXED);
+            added = 1;
+        }
+    }
+    like_unlock(s);
+    if (added) __atomic_fetch_add(&p->rev, 1, __ATOMIC_RELEASE); // Tampilan post berubah
+    return added;
+}
+
+// [Like] Unlike post oleh user. Return 1 jika berhasil, 0 jika user belum like
+int post_remove_like(Post *p, int user_id) {
+    LikeStripe *stripes = __atomic_load_n(&p->likeStripes, __ATOMIC_ACQUIRE);
+    if (!stripes) return 0;
+    unsigned key = (unsigned)user_id + 1;
+    LikeStripe *s = &stripes[(like_hash(key) >> 16) % LIKE_STRIPES];
+    int removed = 0;
+    like_lock(s);
+    if (s->cap) {
+        unsigned *slot = like_slot(s, key);
+        if (*slot & 1) {
+            *slot = key << 1; // Slot tetap milik user ini, dipakai lagi saat like ulang
+            __atomic_store_n(&s->count, s->count - 1, __ATOMIC_RELAXED);
+            removed = 1;
+        }
+    }
+    like_unlock(s);
+    if (removed) __atomic_fetch_add(&p->rev, 1, __ATOMIC_RELEASE);
+    return removed;
+}
+
+// [Like] Salin user_id liker aktif ke array baru (caller free). Return jumlahnya
+int post_liker_ids(Post *p, int **out) {
+    LikeStripe *stripes = __atomic_load_n(&p->likeStripes, __ATOMIC_ACQUIRE);
+    int n = 0, cap = 0;
+    *out = NULL;
+    for (int k = 0; stripes && k < LIKE_STRIPES; k++) {
+        LikeStripe *s = &stripes[k];
+        like_lock(s);
+        for (int i = 0; i < s->cap; i++) {
+            if (!(s->slots[i] & 1)) continue;
+            if (n == cap) {
+                cap = cap ? cap * 2 : 16;
+                *out = (int*)realloc(*out, sizeof(int) * cap);
+            }
+            (*out)[n++] = (int)(s->slots[i] >> 1) - 1;
+        }
+        like_unlock(s);
+    }
+    return n;
+}
+
+// [Like] Byte yang dipakai set liker sebuah post
+long post_like_bytes(const Post *p) {
+    if (!p->likeStripes) return 0;
+    long bytes = sizeof(LikeStripe) * LIKE_STRIPES;
+    for (int k = 0; k < LIKE_STRIPES; k++) bytes += sizeof(unsigned) * p->likeStripes[k].cap;
+    return bytes;
+}
+
+// [Like] Bebaskan set liker (hanya saat tidak ada thread lain)
+void free_post_likes(Post *p) {
+    for (int k = 0; p->likeStripes && k < LIKE_STRIPES; k++)
+        mem_free_sized(MEM_LIKE_TABLE, p->likeStripes[k].slots, sizeof(unsigned) * p->likeStripes[k].cap);
+    mem_free_aligned(MEM_LIKE_STRIPE, p->likeStripes, LIKE_STRIPES * sizeof(LikeStripe));
+    p->likeStripes = NULL;
+}
+
 // ======================= BST untuk Post =========================
 typedef struct PostBSTNode {
     Post *post;
@@ -88,7 +505,7 @@ typedef struct PostBSTNode {
 // [BST] Insert node ke BST Post
 PostBSTNode* insert_post_bst(PostBSTNode *root, Post *post) {
     if (!root) {
-        PostBSTNode *node = (PostBSTNode*)malloc(sizeof(PostBSTNode));
+        PostBSTNode *node = (PostBSTNode*)mem_alloc_sized(MEM_POST_BST, sizeof(PostBSTNode));
         node->post = post;
         node->left = node->right = NULL;
         return node;
@@ -123,11 +540,11 @@ PostBSTNode* delete_post_bst(PostBSTNode *root, int id) {
         root->right = delete_post_bst(root->right, id);
     else {
         if (!root->left && !root->right) { // Leaf
-            free(root);
+            mem_free_sized(MEM_POST_BST, root, sizeof(PostBSTNode));
             return NULL;
         } else if (!root->left || !root->right) { // 1 child
             PostBSTNode *child = root->left ? root->left : root->right;
-            free(root);
+            mem_free_sized(MEM_POST_BST, root, sizeof(PostBSTNode));
             return child;
         } else { // 2 children
             PostBSTNode *succ = find_min_bst(root->right);
@@ -143,7 +560,7 @@ void free_post_bst(PostBSTNode *root) {
     if (!root) return;
     free_post_bst(root->left);
     free_post_bst(root->right);
-    free(root);
+    mem_free_sized(MEM_POST_BST, root, sizeof(PostBSTNode));
 }
 
 // [BST] Build BST dari linked list Post
@@ -167,9 +584,9 @@ typedef struct {
 void heapify(PostHeap *heap, int i) {
     int largest = i;
     int l = 2*i+1, r = 2*i+2;
-    if (l < heap->size && heap->arr[l]->likes > heap->arr[largest]->likes)
+    if (l < heap->size && post_likes(heap->arr[l]) > post_likes(heap->arr[largest]))
         largest = l;
-    if (r < heap->size && heap->arr[r]->likes > heap->arr[largest]->likes)
+    if (r < heap->size && post_likes(heap->arr[r]) > post_likes(heap->arr[largest]))
         largest = r;
     if (largest != i) {
         Post *tmp = heap->arr[i];
@@ -184,14 +601,12 @@ void build_post_heap(PostHeap *heap, Post *head) {
     int n = 0;
     Post *p = head;
     while (p) { n++; p = p->next; }
-    heap->arr = (Post**)malloc(sizeof(Post*) * n);
-    heap->size = n;
+    heap->arr = (Post**)malloc(sizeof(Post*) * (n + 1));
     heap->capacity = n;
-    p = head;
-    for (int i = 0; i < n; i++) {
-        heap->arr[i] = p;
-        p = p->next;
-    }
+    n = 0;
+    for (p = head; p; p = p->next)
+        if (!p->deleted) heap->arr[n++] = p;
+    heap->size = n;
     for (int i = n/2-1; i >= 0; i--)
         heapify(heap, i);
 }
@@ -212,25 +627,34 @@ void free_post_heap(PostHeap *heap) {
 
 // ======================= Stack & Queue =========================
 
-// [Stack] Push ke undo stack (linked list)
-void pushUndo(AppState *app, Post p) {
-    if (p.id == 0) return;
-    UndoNode *node = (UndoNode*)malloc(sizeof(UndoNode));
-    node->post = p;
+// [Stack] Push ke undo stack (linked list): simpan salinan isi + pointer ke post ber-tombstone
+void pushUndo(AppState *app, Post *p) {
+    if (p->id == 0) return;
+    UndoNode *node = (UndoNode*)mem_alloc_sized(MEM_UNDO, sizeof(UndoNode));
+    node->post = *p;
+    node->post.content = NULL; // Undo menyimpan salinan caption sendiri
+    if (p->content) set_post_caption(&node->post, p->content);
+    node->post.likes = post_likes(p);
+    node->post.likeStripes = NULL;
+    node->post.deleted = false;
+    node->post.next = NULL;
+    node->live = p;
     node->next = app->undoTop;
     app->undoTop = node;
 }
 
-// [Stack] Pop dari undo stack
-Post popUndo(AppState *app) {
+// [Stack] Pop dari undo stack. *live berisi post yang masih bisa dipulihkan (atau NULL)
+Post popUndo(AppState *app, Post **live) {
+    *live = NULL;
     if (!app->undoTop) {
         Post empty = {0};
         return empty;
     }
     UndoNode *temp = app->undoTop;
     Post p = temp->post;
+    *live = temp->live;
     app->undoTop = temp->next;
-    free(temp);
+    mem_free_sized(MEM_UNDO, temp, sizeof(UndoNode));
     return p;
 }
 
@@ -239,10 +663,11 @@ int isUndoEmpty(AppState *app) {
     return app->undoTop == NULL;
 }
 
-// [Queue] Enqueue notifikasi ke queue (linked list)
-void enqueueNotif(AppState *app, const char *msg) {
-    NotifNode *node = (NotifNode*)malloc(sizeof(NotifNode));
+// [Queue] Enqueue notifikasi ke queue (linked list). post_id = post yang dirujuk (0 jika tidak ada)
+void enqueueNotif(AppState *app, const char *msg, int post_id) {
+    NotifNode *node = (NotifNode*)mem_alloc_sized(MEM_NOTIF, sizeof(NotifNode));
     strncpy(node->msg, msg, sizeof(node->msg));
+    node->post_id = post_id;
     node->next = NULL;
     if (app->notifRear) {
         app->notifRear->next = node;
@@ -267,7 +692,7 @@ void showNotifications(AppState *app) {
 
 // --- Linked List Insert ---
 void insert_user(AppState *app, User u) {
-    User *newUser = (User*)malloc(sizeof(User));
+    User *newUser = (User*)mem_alloc_sized(MEM_USER, sizeof(User));
     *newUser = u;
     newUser->next = app->users;
     app->users = newUser;
@@ -276,16 +701,29 @@ void insert_user(AppState *app, User u) {
 
 // [Linked List] Insert post ke linked list
 void insert_post(AppState *app, Post p) {
-    Post *newPost = (Post*)malloc(sizeof(Post));
+    Post *newPost = (Post*)mem_alloc_sized(MEM_POST, sizeof(Post));
     *newPost = p;
     newPost->next = app->posts;
     app->posts = newPost;
     app->post_count++;
+    int n = app->post_index_count;
+    if (!app->post_index_valid || (n > 0 && app->postIndexIds[n - 1] >= p.id)) {
+        app->post_index_valid = false;
+        return;
+    }
+    if (n == app->post_index_capacity) { // Tambahkan di ujung index, tetap terurut
+        app->post_index_capacity = n ? n * 2 : 64;
+        app->postIndex = (Post**)mem_realloc(MEM_POST_INDEX, app->postIndex, sizeof(Post*) * app->post_index_capacity);
+        app->postIndexIds = (int*)mem_realloc(MEM_POST_INDEX, app->postIndexIds, sizeof(int) * app->post_index_capacity);
+    }
+    app->postIndex[n] = newPost;
+    app->postIndexIds[n] = p.id;
+    app->post_index_count++;
 }
 
 // Insert a new comment into the linked list
 void insert_comment(AppState *app, Comment c) {
-    Comment *newComment = (Comment*)malloc(sizeof(Comment));
+    Comment *newComment = (Comment*)mem_alloc_sized(MEM_COMMENT, sizeof(Comment));
     *newComment = c;
     newComment->next = app->comments;
     app->comments = newComment;
@@ -304,14 +742,51 @@ void load_users(AppState *app) {
     fclose(file);
 }
 
+// [File I/O] Potong field terakhir dari line (setelah '|' terakhir). Return NULL jika tidak ada '|'
+char* split_last_field(char *line) {
+    char *bar = strrchr(line, '|');
+    if (!bar) return NULL;
+    *bar = '\0';
+    return bar + 1;
+}
+
+// [File I/O] Parse satu baris posts.txt. id & user_id dibaca dari kiri, flag/likes/media dari kanan,
+// sisanya caption (boleh kosong atau memuat '|'). Format lama tanpa kolom cold memakai COLD_MARKER
+bool parse_post_line(char *line, int format, Post *p) {
+    int used = 0;
+    line[strcspn(line, "\r\n")] = '\0';
+    if (sscanf(line, "%d|%d|%n", &p->id, &p->user_id, &used) != 2 || used == 0) return false;
+    char *rest = line + used;
+    char *cold = format >= POSTS_FORMAT ? split_last_field(rest) : NULL;
+    char *likes = split_last_field(rest);
+    char *media = split_last_field(rest);
+    if ((format >= POSTS_FORMAT && !cold) || !likes || !media) return false;
+    p->likes = atoi(likes);
+    p->cold = cold ? atoi(cold) != 0 : strcmp(rest, COLD_MARKER) == 0;
+    snprintf(p->media, MAX_STRING, "%s", media);
+    p->content = NULL; // Caption sebelumnya sudah dimiliki post yang di-insert
+    if (!p->cold) set_post_caption(p, rest);
+    return true;
+}
+
 // [File I/O] Load posts dari file ke linked list
 void load_posts(AppState *app) {
     FILE *file = fopen("posts.txt", "r");
     if (!file) return;
-    Post p;
-    int max_id = 0;
-    while (fscanf(file, "%d|%d|%[^|]|%[^|]|%d\n", &p.id, &p.user_id, p.content, p.media, &p.likes) == 5) {
+    Post p = {0};
+    char line[MAX_STRING * 4];
+    int max_id = 0, format = 1;
+    // Baris pertama: #ID post terbesar yang pernah dipakai (agar ID post yang dihapus tidak dipakai ulang)
+    // dan versi format. File lama tanpa header langsung berisi baris post
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#') {
+            sscanf(line, "#%d|%d", &max_id, &format);
+            continue;
+        }
+        if (!parse_post_line(line, format, &p)) continue; // Baris rusak dilewati, baris berikutnya tetap dimuat
         p.next = NULL;
+        p.likeStripes = NULL;
+        p.deleted = false;
         insert_post(app, p);
         if (p.id > max_id) max_id = p.id;
     }
@@ -324,15 +799,17 @@ void load_comments(AppState *app) {
     FILE *file = fopen("comments.txt", "r");
     if (!file) return;
     Comment c;
-    while (fscanf(file, "%d|%d|%d|%[^]\n", &c.id, &c.post_id, &c.user_id, c.text) == 4) {
+    while (fscanf(file, "%d|%d|%d|%[^\n]\n", &c.id, &c.post_id, &c.user_id, c.text) == 4) {
         c.next = NULL;
         insert_comment(app, c);
+        if (c.id > app->last_comment_id) app->last_comment_id = c.id;
     }
     fclose(file);
 }
 
 // [File I/O] Save users ke file
 void save_users(AppState *app) {
+    if (app->in_memory) return;
     FILE *file = fopen("users.txt", "w");
     User *u = app->users;
     while (u) {
@@ -344,10 +821,13 @@ void save_users(AppState *app) {
 
 // [File I/O] Save posts ke file
 void save_posts(AppState *app) {
+    if (app->in_memory) return;
     FILE *file = fopen("posts.txt", "w");
+    fprintf(file, "#%d|%d\n", app->last_post_id, POSTS_FORMAT);
     Post *p = app->posts;
     while (p) {
-        fprintf(file, "%d|%d|%s|%s|%d\n", p->id, p->user_id, p->content, p->media, p->likes);
+        if (!p->deleted)
+            fprintf(file, "%d|%d|%s|%s|%d|%d\n", p->id, p->user_id, p->cold ? "" : p->content, p->media, post_likes(p), p->cold);
         p = p->next;
     }
     fclose(file);
@@ -355,6 +835,7 @@ void save_posts(AppState *app) {
 
 // [File I/O] Save comments ke file
 void save_comments(AppState *app) {
+    if (app->in_memory) return;
     FILE *file = fopen("comments.txt", "w");
     Comment *c = app->comments;
     while (c) {
@@ -364,584 +845,4344 @@ void save_comments(AppState *app) {
     fclose(file);
 }
 
-// --- Fitur ---
-// Function prototype for insert_user_bst
-UserBSTNode* insert_user_bst(UserBSTNode *root, User *user);
+// ======================= Tiered Storage (Cold Segment) =========================
+// Caption dan comment post lama dipindah (lewat --archive-cold) ke cold.seg. Beberapa post berurutan
+// dikompres bersama dalam satu blok (~COLD_GROUP_BYTES), dengan index cold.idx satu baris per post:
+// post_id|offset|clen|rawlen|start|len (index lama tanpa start|len = satu post per blok).
+// Saat startup hanya index yang dibaca; blok dimuat saat dibutuhkan dan di-cache (LRU).
 
-int signup(AppState *app) {
-    User u;
-    u.id = app->user_count + 1;
-    printf("Username: ");
-    scanf(" %[^\n]", u.username);
-    printf("Email: ");
-    scanf(" %[^\n]", u.email);
-    printf("Password: ");
-    scanf(" %[^\n]", u.password);
-    u.next = NULL;
-    insert_user(app, u);
-    // Tambahkan baris berikut agar BST user ikut di-update
-    app->userBST = insert_user_bst(app->userBST, app->users); // app->users adalah user baru di head
-    save_users(app);
-    printf("Signup successful. Please login.\n");
-    return -1;
+// [Cold] Flush literal run ke output kompresi
+int cold_emit_literals(const unsigned char *in, int start, int end, unsigned char *out, int op) {
+    while (start < end) {
+        int run = end - start > 128 ? 128 : end - start;
+        out[op++] = (unsigned char)(run - 1);
+        memcpy(out + op, in + start, run);
+        op += run;
+        start += run;
+    }
+    return op;
 }
 
-// Log user activity
-void log_activity(const char *msg) {
-    FILE *file = fopen("log.txt", "a");
-    if (file) {
-        fprintf(file, "%s\n", msg);
-        fclose(file);
+// [Cold] Kompres blok (LZ77 sederhana). Kapasitas out minimal n + n/128 + 1
+int cold_compress(const unsigned char *in, int n, unsigned char *out) {
+    int table[4096];
+    for (int i = 0; i < 4096; i++) table[i] = -1;
+    int ip = 0, op = 0, lit_start = 0;
+    while (ip + 3 <= n) {
+        unsigned key = (unsigned)in[ip] << 16 | (unsigned)in[ip+1] << 8 | in[ip+2];
+        unsigned h = (key * 2654435761u) >> 20;
+        int cand = table[h];
+        table[h] = ip;
+        if (cand >= 0 && ip - cand <= 0xFFFF && memcmp(in + cand, in + ip, 3) == 0) {
+            op = cold_emit_literals(in, lit_start, ip, out, op);
+            int len = 3;
+            while (ip + len < n && len < 130 && in[cand + len] == in[ip + len]) len++;
+            int off = ip - cand;
+            out[op++] = (unsigned char)(0x80 | (len - 3));
+            out[op++] = (unsigned char)(off & 0xFF);
+            out[op++] = (unsigned char)(off >> 8);
+            ip += len;
+            lit_start = ip;
+        } else {
+            ip++;
+        }
     }
+    return cold_emit_literals(in, lit_start, n, out, op);
 }
 
-// Function prototype for search_user_bst
-User* search_user_bst(UserBSTNode *root, const char *username);
+// [Cold] Dekompres blok. Return panjang hasil, -1 jika blok rusak
+int cold_decompress(const unsigned char *in, int n, unsigned char *out, int cap) {
+    int ip = 0, op = 0;
+    while (ip < n) {
+        int c = in[ip++];
+        if (c < 0x80) {
+            int run = c + 1;
+            if (ip + run > n || op + run > cap) return -1;
+            memcpy(out + op, in + ip, run);
+            ip += run;
+            op += run;
+        } else {
+            if (ip + 2 > n) return -1;
+            int len = (c & 0x7F) + 3;
+            int off = in[ip] | in[ip+1] << 8;
+            ip += 2;
+            if (off == 0 || off > op || op + len > cap) return -1;
+            for (int k = 0; k < len; k++, op++) out[op] = out[op - off];
+        }
+    }
+    return op;
+}
 
-// Login
-int login(AppState *app) {
-    char uname[MAX_STRING], pass[MAX_STRING];
-    printf("Username: ");
-    scanf(" %[^\n]", uname);
-    printf("Password: ");
-    scanf(" %[^\n]", pass);
-    User *u = search_user_bst(app->userBST, uname);
-    if (u && strcmp(u->password, pass) == 0) {
-        printf("Login successful!\n");
-        char logmsg[MAX_STRING * 2];
-        snprintf(logmsg, sizeof(logmsg), "User %s logged in.", uname);
-        log_activity(logmsg);
-        return u->id;
+// [Cold] Load index segment cold (baris pertama: #id comment terbesar di segment)
+void load_cold_index(AppState *app) {
+    FILE *file = fopen("cold.idx", "r");
+    if (!file) return;
+    int max_comment_id;
+    if (fscanf(file, "#%d\n", &max_comment_id) == 1 && max_comment_id > app->last_comment_id)
+        app->last_comment_id = max_comment_id;
+    int capacity = 0;
+    ColdIndexEntry e;
+    char line[128];
+    while (fgets(line, sizeof(line), file)) {
+        int fields = sscanf(line, "%d|%ld|%d|%d|%d|%d", &e.post_id, &e.offset, &e.clen, &e.rawlen, &e.start, &e.len);
+        if (fields == 4) { // Format lama: blok hanya berisi post ini
+            e.start = 0;
+            e.len = e.rawlen;
+        } else if (fields != 6) {
+            continue;
+        }
+        if (app->cold_count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            app->coldIndex = (ColdIndexEntry*)mem_realloc(MEM_COLD_INDEX, app->coldIndex, sizeof(ColdIndexEntry) * capacity);
+        }
+        app->coldIndex[app->cold_count++] = e;
     }
-    printf("Login failed.\n");
-    return -1;
+    fclose(file);
 }
 
-// Create post
-void create_post(AppState *app) {
-    Post p;
-    p.id = ++app->last_post_id;
-    p.user_id = app->current_user_id;
-    printf("Media Filename (png, jpg, etc): ");
-    scanf(" %[^\n]", p.media);
-    printf("Caption: ");
-    scanf(" %[^\n]", p.content);
-    p.likes = 0;
-    p.next = NULL;
-    insert_post(app, p);
-    save_posts(app);
-    printf("Post created.\n");
+// [Cold] Binary search entry index (index ditulis terurut post_id)
+ColdIndexEntry* find_cold_entry(AppState *app, int post_id) {
+    int left = 0, right = app->cold_count - 1;
+    while (left <= right) {
+        int mid = left + (right - left) / 2;
+        if (app->coldIndex[mid].post_id == post_id) return &app->coldIndex[mid];
+        if (app->coldIndex[mid].post_id < post_id) left = mid + 1;
+        else right = mid - 1;
+    }
+    return NULL;
 }
 
-// View posts
-// Function prototype for bubble_sort_posts_by_id
-void bubble_sort_posts_by_id(Post **arr, int n);
+// [Cold] Lepas blok dari cache (hash + LRU) dan bebaskan memorinya
+void evict_cold_block(AppState *app, ColdBlock *b) {
+    ColdBlock **pp = &app->coldBuckets[(unsigned)b->post_id % COLD_CACHE_BUCKETS];
+    while (*pp != b) pp = &(*pp)->hnext;
+    *pp = b->hnext;
+    if (b->prev) b->prev->next = b->next; else app->coldHead = b->next;
+    if (b->next) b->next->prev = b->prev; else app->coldTail = b->prev;
+    app->cold_cache_bytes -= b->bytes;
+    mem_free(MEM_COLD_CACHE, b->raw);
+    mem_free(MEM_COLD_CACHE, b->comments);
+    mem_free_sized(MEM_COLD_CACHE, b, sizeof(ColdBlock));
+}
 
-void view_posts(AppState *app) {
-    int n = 0;
-    Post *p = app->posts;
-    while (p) { n++; p = p->next; }
-    if (n == 0) {
-        printf("\n>> Belum ada postingan.\n");
-        return;
-    }
-    Post **arr = (Post**)malloc(sizeof(Post*) * n);
-    p = app->posts;
-    for (int i = 0; i < n; i++) {
-        arr[i] = p;
-        p = p->next;
+// [Cold] Parse blok mentah: baris pertama caption, sisanya "id|user_id|text"
+void parse_cold_block(ColdBlock *b) {
+    char *line = b->raw;
+    char *nl = strchr(line, '\n');
+    b->caption = line;
+    if (!nl) return;
+    *nl = '\0';
+    line = nl + 1;
+    int lines = 0;
+    for (char *q = line; *q; q++)
+        if (*q == '\n') lines++;
+    b->comments = (Comment*)mem_alloc(MEM_COLD_CACHE, sizeof(Comment) * (lines ? lines : 1));
+    while (*line) {
+        nl = strchr(line, '\n');
+        if (nl) *nl = '\0';
+        Comment *c = &b->comments[b->comment_count];
+        if (sscanf(line, "%d|%d|%99[^\n]", &c->id, &c->user_id, c->text) == 3) {
+            c->post_id = b->post_id;
+            c->next = NULL;
+            b->comment_count++;
+        }
+        if (!nl) break;
+        line = nl + 1;
     }
-    bubble_sort_posts_by_id(arr, n);
-    printf("\n====================[ Daftar Postingan ]====================\n");
-    for (int i = 0; i < n; i++) {
-        printf("\n------------------------------------------------------------\n");
-        printf("[%d] User %d: %s (%s) Likes: %d\n", arr[i]->id, arr[i]->user_id, arr[i]->content, arr[i]->media, arr[i]->likes);
-        // Print comments (reverse order)
-        int stack_count = 0;
-        Comment *stack[1000];
-        Comment *c = app->comments;
-        while (c) {
-            if (c->post_id == arr[i]->id) stack[stack_count++] = c;
-            c = c->next;
-        }
-        while (stack_count > 0) {
-            Comment *cc = stack[--stack_count];
-            printf("  - Comment from User %d: %s\n", cc->user_id, cc->text);
-        }
-    }
-    printf("\n============================================================\n");
-    free(arr);
 }
 
-// [Linked List] Like post
-void like_post(AppState *app) {
-    int pid;
-    printf("Enter post ID to like: ");
-    scanf("%d", &pid);
-    Post *p = app->posts;
-    while (p) {
-        if (p->id == pid) {
-            // Cek apakah user sudah like
-            LikeNode *ln = p->likeList;
-            while (ln) {
-                if (ln->user_id == app->current_user_id) {
-                    printf("Anda sudah like post ini.\n");
-                    return;
-                }
-                ln = ln->next;
-            }
-            // Tambah like
-            LikeNode *newLike = (LikeNode*)malloc(sizeof(LikeNode));
-            newLike->user_id = app->current_user_id;
-            newLike->next = p->likeList;
-            p->likeList = newLike;
-            p->likes++;
-            save_posts(app); // (opsional: simpan likeList ke file jika ingin persistent)
-            printf("Post liked!\n");
-            char notif[MAX_STRING * 2];
-            snprintf(notif, sizeof(notif), "You liked post ID %d", p->id);
-            enqueueNotif(app, notif);
-            return;
-        }
-        p = p->next;
+// [Cold] Dekompres blok cold.seg yang ditunjuk entry. Blok terakhir disimpan agar post lain
+// di blok yang sama tidak dibaca & didekompres ulang
+const char* load_cold_group(AppState *app, ColdIndexEntry *e) {
+    if (app->coldGroup && app->cold_group_offset == e->offset) return app->coldGroup;
+    if (!app->coldSeg) app->coldSeg = fopen("cold.seg", "rb");
+    if (!app->coldSeg) return NULL;
+    unsigned char *packed = (unsigned char*)malloc(e->clen);
+    char *raw = (char*)mem_alloc(MEM_COLD_CACHE, e->rawlen + 1);
+    if (fseek(app->coldSeg, e->offset, SEEK_SET) != 0 ||
+        fread(packed, 1, e->clen, app->coldSeg) != (size_t)e->clen ||
+        cold_decompress(packed, e->clen, (unsigned char*)raw, e->rawlen) != e->rawlen) {
+        free(packed);
+        mem_free(MEM_COLD_CACHE, raw);
+        return NULL;
     }
-    printf("Post not found.\n");
+    free(packed);
+    raw[e->rawlen] = '\0';
+    mem_free(MEM_COLD_CACHE, app->coldGroup);
+    app->coldGroup = raw;
+    app->cold_group_offset = e->offset;
+    return raw;
 }
 
-// [Linked List] Unlike post
-void unlike_post(AppState *app) {
-    int pid;
-    printf("\nEnter post ID to unlike: ");
-    scanf("%d", &pid);
-    Post *p = app->posts;
-    while (p) {
-        if (p->id == pid) {
-            LikeNode **ln = &p->likeList;
-            while (*ln) {
-                if ((*ln)->user_id == app->current_user_id) {
-                    // Hapus LikeNode milik user ini
-                    LikeNode *del = *ln;
-                    *ln = del->next;
-                    free(del);
-                    p->likes--;
-                    save_posts(app);
-                    printf("Post unliked!\n");
-                    char notif[MAX_STRING * 2];
-                    snprintf(notif, sizeof(notif), "You unliked post ID %d", p->id);
-                    enqueueNotif(app, notif);
-                    return;
-                }
-                ln = &(*ln)->next;
-            }
-            // Jika tidak ditemukan LikeNode user ini
-            printf("Anda belum like post ini.\n");
-            return;
+// [Cold] Ambil blok cold milik post (dari cache, atau potong dari blok cold.seg yang didekompres)
+ColdBlock* load_cold_block(AppState *app, int post_id) {
+    unsigned bucket = (unsigned)post_id % COLD_CACHE_BUCKETS;
+    for (ColdBlock *b = app->coldBuckets[bucket]; b; b = b->hnext) {
+        if (b->post_id != post_id) continue;
+        if (b != app->coldHead) { // Pindah ke depan LRU
+            b->prev->next = b->next;
+            if (b->next) b->next->prev = b->prev; else app->coldTail = b->prev;
+            b->prev = NULL;
+            b->next = app->coldHead;
+            app->coldHead->prev = b;
+            app->coldHead = b;
         }
-        p = p->next;
+        return b;
     }
-    printf("Post not found.\n");
+    ColdIndexEntry *e = find_cold_entry(app, post_id);
+    if (!e || e->start < 0 || e->len < 0 || e->start > e->rawlen - e->len) return NULL;
+    const char *group = load_cold_group(app, e);
+    if (!group) return NULL;
+    char *raw = (char*)mem_alloc(MEM_COLD_CACHE, e->len + 1);
+    memcpy(raw, group + e->start, e->len);
+    raw[e->len] = '\0';
+
+    ColdBlock *b = (ColdBlock*)mem_calloc_sized(MEM_COLD_CACHE, sizeof(ColdBlock));
+    b->post_id = post_id;
+    b->raw = raw;
+    parse_cold_block(b);
+    b->bytes = sizeof(ColdBlock) + e->len + 1 + sizeof(Comment) * b->comment_count;
+    b->hnext = app->coldBuckets[bucket];
+    app->coldBuckets[bucket] = b;
+    b->next = app->coldHead;
+    if (app->coldHead) app->coldHead->prev = b; else app->coldTail = b;
+    app->coldHead = b;
+    app->cold_cache_bytes += b->bytes;
+    while (app->cold_cache_bytes > COLD_CACHE_BYTES && app->coldTail != b)
+        evict_cold_block(app, app->coldTail);
+    return b;
 }
 
-// [Linked List] Comment post
-void comment_post(AppState *app) {
-    int pid;
-    Comment c;
-    c.id = app->comment_count + 1;
-    c.user_id = app->current_user_id;
-    printf("Enter post ID to comment: ");
-    scanf("%d", &pid);
-    c.post_id = pid;
-    printf("Comment: ");
-    scanf(" %[^\n]", c.text);
-    c.next = NULL;
-    insert_comment(app, c);
-    save_comments(app);
-    printf("Comment added.\n");
-    char notif[MAX_STRING * 2];
-    snprintf(notif, sizeof(notif), "You commented on post ID %d", pid);
-    enqueueNotif(app, notif);
+// [Cold] Caption post (dimuat dari segment cold jika perlu)
+const char* post_caption(AppState *app, Post *p) {
+    if (!p->cold) return p->content;
+    ColdBlock *b = load_cold_block(app, p->id);
+    return b ? b->caption : "";
 }
 
-// [Linked List & Stack] Delete post (dari linked list, push ke undo stack)
-void delete_post(AppState *app) {
-    int pid;
-    printf("Enter post ID to delete: ");
-    scanf("%d", &pid);
+// [Cold] Jadikan post hot lagi: caption & comment dipindah ke memori (mis. sebelum edit).
+// Return false (post tetap cold) jika blok tidak bisa dimuat
+bool warm_post(AppState *app, Post *p) {
+    if (!p->cold) return true;
+    ColdBlock *b = load_cold_block(app, p->id);
+    if (!b) return false;
+    set_post_caption(p, b->caption);
+    for (int i = 0; i < b->comment_count; i++)
+        insert_comment(app, b->comments[i]);
+    evict_cold_block(app, b);
+    p->cold = false;
+    return true;
+}
 
-    // Hapus dari linked list
-    Post **pp = &app->posts;
-    while (*pp) {
-        if ((*pp)->id == pid && (*pp)->user_id == app->current_user_id) {
-            pushUndo(app, **pp);
-            Post *del = *pp;
-            *pp = del->next;
-            free(del);
-            app->post_count--;
-            save_posts(app);
-            printf("Post deleted. (Undo available)\n");
-            char notif[MAX_STRING * 2];
-            snprintf(notif, sizeof(notif), "You deleted post ID %d", pid);
-            enqueueNotif(app, notif);
+// [Cold] Bebaskan index dan cache segment cold
+void free_cold_storage(AppState *app) {
+    while (app->coldHead) evict_cold_block(app, app->coldHead);
+    mem_free(MEM_COLD_INDEX, app->coldIndex);
+    app->coldIndex = NULL;
+    app->cold_count = 0;
+    if (app->coldSeg) fclose(app->coldSeg);
+    app->coldSeg = NULL;
+    mem_free(MEM_COLD_CACHE, app->coldGroup);
+    app->coldGroup = NULL;
+}
+
+// ======================= Render Cache =========================
+// view_posts merender tiap post (header + comment) sekali, lalu menyalin teks jadinya pada view
+// berikutnya. Blok valid selama revisi post tidak berubah: like/unlike menaikkan revisi lewat
+// post_add_like/post_remove_like, edit_post & comment_post lewat render_cache_touch, delete_post membuang bloknya.
+
+// Function prototype for append_buf
+void append_buf(char **buf, int *len, int *cap, const char *text);
+
+// [Render] Tandai tampilan post berubah (blok cache-nya jadi basi)
+void render_cache_touch(Post *p) {
+    __atomic_fetch_add(&p->rev, 1, __ATOMIC_RELEASE);
+}
+
+// [Render] Lepas blok dari cache (hash + LRU) dan bebaskan memorinya
+void evict_render_block(AppState *app, RenderBlock *b) {
+    RenderBlock **pp = &app->renderBuckets[(unsigned)b->post_id % RENDER_CACHE_BUCKETS];
+    while (*pp != b) pp = &(*pp)->hnext;
+    *pp = b->hnext;
+    if (b->prev) b->prev->next = b->next; else app->renderHead = b->next;
+    if (b->next) b->next->prev = b->prev; else app->renderTail = b->prev;
+    app->render_cache_bytes -= b->bytes;
+    mem_free(MEM_RENDER_CACHE, b->text);
+    mem_free_sized(MEM_RENDER_CACHE, b, sizeof(RenderBlock));
+}
+
+// [Render] Buang blok milik post (mis. post dihapus)
+void render_cache_drop(AppState *app, int post_id) {
+    for (RenderBlock *b = app->renderBuckets[(unsigned)post_id % RENDER_CACHE_BUCKETS]; b; b = b->hnext) {
+        if (b->post_id == post_id) {
+            evict_render_block(app, b);
             return;
         }
-        pp = &(*pp)->next;
     }
-    printf("Post not found or you are not the owner.\n");
 }
 
-// [Linked List] Edit post
-void edit_post(AppState *app) {
-    int pid;
-    printf("Enter post ID to edit: ");
-    scanf("%d", &pid);
-    Post *p = app->posts;
-    while (p) {
-        if (p->id == pid && p->user_id == app->current_user_id) {
-            printf("New Media Filename (png, jpg, etc): ");
-            scanf(" %[^\n]", p->media);
-            printf("New Caption: ");
-            scanf(" %[^\n]", p->content);
-            save_posts(app);
-            printf("Post updated.\n");
-            return;
+// [Render] Render header + comment satu post ke buffer (comment cold dulu, lalu hot terbaru dulu)
+void render_post(AppState *app, Post *p, char **buf, int *len, int *cap) {
+    char line[MAX_STRING * 4];
+    append_buf(buf, len, cap, "\n------------------------------------------------------------\n");
+    snprintf(line, sizeof(line), "[%d] User %d: %s (%s) Likes: %d\n", p->id, p->user_id, post_caption(app, p), p->media, post_likes(p));
+    append_buf(buf, len, cap, line);
+    // Comment lama dari segment cold (urut ID)
+    if (p->cold) {
+        ColdBlock *b = load_cold_block(app, p->id);
+        for (int k = 0; b && k < b->comment_count; k++) {
+            snprintf(line, sizeof(line), "  - Comment from User %d: %s\n", b->comments[k].user_id, b->comments[k].text);
+            append_buf(buf, len, cap, line);
         }
-        p = p->next;
     }
-    printf("Post not found or unauthorized.\n");
+    // Print comments (reverse order)
+    int stack_count = 0;
+    Comment *stack[1000];
+    for (Comment *c = app->comments; c && stack_count < 1000; c = c->next)
+        if (c->post_id == p->id) stack[stack_count++] = c;
+    while (stack_count > 0) {
+        Comment *cc = stack[--stack_count];
+        snprintf(line, sizeof(line), "  - Comment from User %d: %s\n", cc->user_id, cc->text);
+        append_buf(buf, len, cap, line);
+    }
 }
 
-// [Heap] Tampilkan top 3 post by likes
-void sort_and_show_posts_by_likes(AppState *app) {
-    if (!app->posts) {
-        printf("No posts.\n");
+// [Render] Tulis tampilan post ke out dari cache, render ulang jika belum ada atau basi
+void write_cached_post(AppState *app, Post *p, FILE *out) {
+    char *text = NULL;
+    int text_len = 0, text_cap = 0;
+    if (app->render_cache_cap == 0) { // Cache nonaktif
+        render_post(app, p, &text, &text_len, &text_cap);
+        fwrite(text, 1, text_len, out);
+        free(text);
         return;
     }
-    PostHeap heap;
-    build_post_heap(&heap, app->posts);
-    printf("Top 3 Posts by Likes:\n");
-    for (int i = 0; i < 3 && heap.size > 0; i++) {
-        Post *p = extract_max(&heap);
-        printf("[%d] User %d: %s (%s) Likes: %d\n", p->id, p->user_id, p->content, p->media, p->likes);
+    unsigned bucket = (unsigned)p->id % RENDER_CACHE_BUCKETS;
+    unsigned rev = __atomic_load_n(&p->rev, __ATOMIC_ACQUIRE);
+    RenderBlock *b = app->renderBuckets[bucket];
+    while (b && b->post_id != p->id) b = b->hnext;
+    if (b && b->rev == rev) {
+        app->render_hits++;
+        if (b != app->renderHead) { // Pindah ke depan LRU
+            b->prev->next = b->next;
+            if (b->next) b->next->prev = b->prev; else app->renderTail = b->prev;
+            b->prev = NULL;
+            b->next = app->renderHead;
+            app->renderHead->prev = b;
+            app->renderHead = b;
+        }
+        fwrite(b->text, 1, b->len, out);
+        return;
+    }
+    app->render_misses++;
+    if (b) evict_render_block(app, b);
+
+    render_post(app, p, &text, &text_len, &text_cap);
+    fwrite(text, 1, text_len, out);
+    size_t bytes = sizeof(RenderBlock) + text_len + 1;
+    if (bytes > app->render_cache_cap) { // Tidak muat di cache
+        free(text);
+        return;
+    }
+    b = (RenderBlock*)mem_calloc_sized(MEM_RENDER_CACHE, sizeof(RenderBlock));
+    b->post_id = p->id;
+    b->rev = rev;
+    b->text = (char*)mem_alloc(MEM_RENDER_CACHE, text_len + 1);
+    memcpy(b->text, text, text_len + 1);
+    free(text);
+    b->len = text_len;
+    b->bytes = bytes;
+    b->hnext = app->renderBuckets[bucket];
+    app->renderBuckets[bucket] = b;
+    b->next = app->renderHead;
+    if (app->renderHead) app->renderHead->prev = b; else app->renderTail = b;
+    app->renderHead = b;
+    app->render_cache_bytes += bytes;
+    while (app->render_cache_bytes > app->render_cache_cap && app->renderTail != b) {
+        evict_render_block(app, app->renderTail);
+        app->render_evictions++;
+    }
+}
+
+// [Render] Bebaskan seluruh cache render
+void free_render_cache(AppState *app) {
+    while (app->renderHead) evict_render_block(app, app->renderHead);
+}
+
+// [Render] Statistik cache render
+void show_render_cache_stats(AppState *app, FILE *out) {
+    long total = app->render_hits + app->render_misses;
+    int blocks = 0;
+    for (RenderBlock *b = app->renderHead; b; b = b->next) blocks++;
+    fprintf(out, "Cache render       : %d blok, %zu / %zu bytes\n", blocks, app->render_cache_bytes, app->render_cache_cap);
+    fprintf(out, "Hit rate render    : %.1f%% (%ld hit, %ld miss, %ld evict)\n",
+            total ? 100.0 * app->render_hits / total : 0.0, app->render_hits, app->render_misses, app->render_evictions);
+}
+
+// ======================= Compactor (Tombstone) =========================
+// delete_post hanya menandai post (tombstone). compact_step mereklamasi secara bertahap
+// dengan budget node per panggilan: 1) unlink post ber-tombstone + like-nya,
+// 2) sweep comment & index BST comment milik post tsb, 3) sweep notifikasi yang merujuknya.
+
+#define COMPACT_BUDGET 256 // Node yang diperiksa per aksi menu
+#define COMPACT_GRACE 10 // Tombstone baru direklamasi setelah sekian aksi (undo cukup hapus tombstone)
+enum { COMPACT_IDLE, COMPACT_POSTS, COMPACT_COMMENTS, COMPACT_NOTIFS };
+
+// Function prototype for delete_comment_bst
+CommentBSTNode* delete_comment_bst(CommentBSTNode *root, int id);
+// Function prototype for unindex_text_tags
+void unindex_text_tags(AppState *app, int post_id, const char *text);
+
+int cmp_int(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// [Compactor] Byte yang dipakai post beserta like-nya
+long post_footprint(Post *p) {
+    return sizeof(Post) + (p->content ? strlen(p->content) + 1 : 0) + post_like_bytes(p);
+}
+
+// [Compactor] Cek apakah post sudah direklamasi pada siklus ini
+bool is_dead_post(AppState *app, int post_id) {
+    if (app->dead_count == 0) return false;
+    return bsearch(&post_id, app->deadIds, app->dead_count, sizeof(int), cmp_int) != NULL;
+}
+
+// [Compactor] Bebaskan post ber-tombstone yang sudah di-unlink dari list
+void reclaim_post(AppState *app, Post *p) {
+    if (app->dead_count == app->dead_capacity) {
+        app->dead_capacity = app->dead_capacity ? app->dead_capacity * 2 : 16;
+        app->deadIds = (int*)mem_realloc(MEM_COMPACTOR, app->deadIds, sizeof(int) * app->dead_capacity);
+    }
+    app->deadIds[app->dead_count++] = p->id;
+    for (UndoNode *un = app->undoTop; un; un = un->next)
+        if (un->live == p) un->live = NULL;
+    unindex_text_tags(app, p->id, post_caption(app, p)); // Comment hot dilepas saat sweep comment
+    ColdBlock *b = p->cold ? load_cold_block(app, p->id) : NULL;
+    for (int i = 0; b && i < b->comment_count; i++)
+        unindex_text_tags(app, p->id, b->comments[i].text);
+    app->reclaimed_bytes += post_footprint(p);
+    app->tombstones--;
+    app->post_index_valid = false;
+    free_post_likes(p);
+    drop_post_caption(p);
+    mem_free_sized(MEM_POST, p, sizeof(Post));
+}
+
+// [Compactor] Jalankan reklamasi inkremental, memeriksa paling banyak `budget` node.
+// Maksimal satu siklus selesai per panggilan
+void compact_step(AppState *app, int budget) {
+    while (budget-- > 0) {
+        if (app->compact_phase == COMPACT_IDLE) {
+            if (app->tombstones == 0) return;
+            app->compact_phase = COMPACT_POSTS;
+            app->compactPost = &app->posts;
+        } else if (app->compact_phase == COMPACT_POSTS) {
+            Post *p = *app->compactPost;
+            if (!p) {
+                if (app->dead_count == 0) { // Semua tombstone masih dalam masa grace
+                    app->compact_phase = COMPACT_IDLE;
+                    return;
+                }
+                qsort(app->deadIds, app->dead_count, sizeof(int), cmp_int);
+                app->compact_phase = COMPACT_COMMENTS;
+                app->compactComment = &app->comments;
+            } else if (p->deleted && (app->compact_flush || app->action_seq - p->deleted_seq >= COMPACT_GRACE)) {
+                *app->compactPost = p->next;
+                reclaim_post(app, p);
+            } else {
+                app->compactPost = &p->next;
+            }
+        } else if (app->compact_phase == COMPACT_COMMENTS) {
+            Comment *c = *app->compactComment;
+            if (!c) {
+                if (app->compact_dirty) save_comments(app);
+                app->compact_dirty = false;
+                app->compact_phase = COMPACT_NOTIFS;
+                app->compactNotif = &app->notifFront;
+                app->compactNotifPrev = NULL;
+            } else if (is_dead_post(app, c->post_id)) {
+                *app->compactComment = c->next;
+                unindex_text_tags(app, c->post_id, c->text);
+                app->commentBST = delete_comment_bst(app->commentBST, c->id);
+                app->comment_count--;
+                app->reclaimed_bytes += sizeof(Comment);
+                mem_free_sized(MEM_COMMENT, c, sizeof(Comment));
+                app->compact_dirty = true;
+            } else {
+                app->compactComment = &c->next;
+            }
+        } else {
+            NotifNode *nn = *app->compactNotif;
+            if (!nn) {
+                app->dead_count = 0;
+                app->compact_phase = COMPACT_IDLE;
+                return;
+            } else if (nn->post_id && is_dead_post(app, nn->post_id)) {
+                *app->compactNotif = nn->next;
+                if (app->notifRear == nn) app->notifRear = app->compactNotifPrev;
+                app->reclaimed_bytes += sizeof(NotifNode);
+                mem_free_sized(MEM_NOTIF, nn, sizeof(NotifNode));
+            } else {
+                app->compactNotifPrev = nn;
+                app->compactNotif = &nn->next;
+            }
+        }
+    }
+}
+
+// [Compactor] Selesaikan siklus reklamasi yang sedang berjalan
+void compact_finish_cycle(AppState *app) {
+    while (app->compact_phase != COMPACT_IDLE)
+        compact_step(app, COMPACT_BUDGET);
+}
+
+// [Compactor] Reklamasi semua tombstone sekarang tanpa masa grace, termasuk comment-nya di
+// comments.txt. Dipanggil sebelum store ditinggalkan (logout, exit, akhir tool CLI) karena
+// tombstone tidak ikut disimpan
+void compact_all(AppState *app) {
+    compact_finish_cycle(app);
+    app->compact_flush = true;
+    while (app->tombstones > 0 || app->compact_phase != COMPACT_IDLE)
+        compact_step(app, COMPACT_BUDGET);
+    app->compact_flush = false;
+}
+
+// [Compactor] Hitung byte yang masih bisa direklamasi (post ber-tombstone, like, comment)
+long reclaimable_bytes(AppState *app) {
+    long bytes = 0;
+    int n = 0;
+    for (Post *p = app->posts; p; p = p->next)
+        if (p->deleted) n++;
+    int *ids = (int*)malloc(sizeof(int) * (n + app->dead_count + 1));
+    n = 0;
+    for (Post *p = app->posts; p; p = p->next) {
+        if (!p->deleted) continue;
+        ids[n++] = p->id;
+        bytes += post_footprint(p);
+    }
+    for (int i = 0; i < app->dead_count; i++) ids[n++] = app->deadIds[i];
+    qsort(ids, n, sizeof(int), cmp_int);
+    for (Comment *c = app->comments; c; c = c->next)
+        if (bsearch(&c->post_id, ids, n, sizeof(int), cmp_int)) bytes += sizeof(Comment);
+    for (NotifNode *nn = app->notifFront; nn; nn = nn->next)
+        if (nn->post_id && bsearch(&nn->post_id, ids, n, sizeof(int), cmp_int)) bytes += sizeof(NotifNode);
+    free(ids);
+    return bytes;
+}
+
+// [Compactor] Tampilkan status tombstone dan memori yang bisa direklamasi
+void show_storage_status(AppState *app) {
+    printf("\n==================[ Storage Status ]==================\n");
+    printf("Post ber-tombstone : %d\n", app->tombstones);
+    printf("Bisa direklamasi   : %ld bytes\n", reclaimable_bytes(app));
+    printf("Sudah direklamasi  : %ld bytes\n", app->reclaimed_bytes);
+    show_render_cache_stats(app, stdout);
+    printf("=====================================================\n");
+}
+
+// ======================= Sort & Search Kernels =========================
+// Kernel di atas array key yang contiguous (ID post, likes, ID user):
+// - LSD radix sort 8-bit (4 pass, pass dilewati jika semua byte sama), stabil
+// - sort multi-key stabil: likes turun, lalu ID naik
+// - lower bound branchless (compiler menghasilkan cmov, tanpa branch misprediction)
+
+// [Kernel] Ubah int ke key unsigned yang urutannya sama
+unsigned int_key(int v) {
+    return (unsigned)v ^ 0x80000000u;
+}
+
+// [Kernel] LSD radix sort stabil atas keys, vals ikut dipermutasi
+void radix_sort_pairs(unsigned *keys, int *vals, int n) {
+    if (n < 2) return;
+    unsigned *tmp_keys = (unsigned*)malloc(sizeof(unsigned) * n);
+    int *tmp_vals = (int*)malloc(sizeof(int) * n);
+    int count[256];
+    for (int shift = 0; shift < 32; shift += 8) {
+        memset(count, 0, sizeof(count));
+        for (int i = 0; i < n; i++) count[(keys[i] >> shift) & 0xFF]++;
+        if (count[(keys[0] >> shift) & 0xFF] == n) continue; // Semua byte sama
+        int sum = 0;
+        for (int d = 0; d < 256; d++) {
+            int c = count[d];
+            count[d] = sum;
+            sum += c;
+        }
+        for (int i = 0; i < n; i++) {
+            int pos = count[(keys[i] >> shift) & 0xFF]++;
+            tmp_keys[pos] = keys[i];
+            tmp_vals[pos] = vals[i];
+        }
+        memcpy(keys, tmp_keys, sizeof(unsigned) * n);
+        memcpy(vals, tmp_vals, sizeof(int) * n);
+    }
+    free(tmp_keys);
+    free(tmp_vals);
+}
+
+// [Kernel] Terapkan permutasi order ke array Post
+void permute_posts(Post **arr, const int *order, int n) {
+    Post **tmp = (Post**)malloc(sizeof(Post*) * n);
+    for (int i = 0; i < n; i++) tmp[i] = arr[order[i]];
+    memcpy(arr, tmp, sizeof(Post*) * n);
+    free(tmp);
+}
+
+// [Kernel] Urutkan array Post berdasarkan ID (naik) dengan radix sort
+void radix_sort_posts_by_id(Post **arr, int n) {
+    if (n < 2) return;
+    unsigned *keys = (unsigned*)malloc(sizeof(unsigned) * n);
+    int *order = (int*)malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) {
+        keys[i] = int_key(arr[i]->id);
+        order[i] = i;
+    }
+    radix_sort_pairs(keys, order, n);
+    permute_posts(arr, order, n);
+    free(keys);
+    free(order);
+}
+
+// [Kernel] Ranking Post: likes terbanyak dulu, seri diurutkan ID naik (dua pass radix stabil)
+void radix_rank_posts_by_likes(Post **arr, int n) {
+    if (n < 2) return;
+    unsigned *keys = (unsigned*)malloc(sizeof(unsigned) * n);
+    int *order = (int*)malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) {
+        keys[i] = int_key(arr[i]->id);
+        order[i] = i;
+    }
+    radix_sort_pairs(keys, order, n);
+    for (int i = 0; i < n; i++) keys[i] = ~int_key(post_likes(arr[order[i]]));
+    radix_sort_pairs(keys, order, n);
+    permute_posts(arr, order, n);
+    free(keys);
+    free(order);
+}
+
+// [Kernel] Lower bound branchless: indeks pertama dengan keys[i] >= x (n jika tidak ada)
+int lower_bound_int(const int *keys, int n, int x) {
+    if (n == 0) return 0;
+    const int *base = keys;
+    while (n > 1) {
+        int half = n / 2;
+        base = base[half] < x ? base + half : base;
+        n -= half;
+    }
+    return (int)(base - keys) + (*base < x);
+}
+
+// [Kernel] Bangun ulang index ID post (ID terurut + pointer Post)
+void rebuild_post_index(AppState *app) {
+    int n = 0;
+    for (Post *p = app->posts; p; p = p->next) n++;
+    app->postIndex = (Post**)mem_realloc(MEM_POST_INDEX, app->postIndex, sizeof(Post*) * (n + 1));
+    app->postIndexIds = (int*)mem_realloc(MEM_POST_INDEX, app->postIndexIds, sizeof(int) * (n + 1));
+    n = 0;
+    for (Post *p = app->posts; p; p = p->next) app->postIndex[n++] = p;
+    radix_sort_posts_by_id(app->postIndex, n);
+    for (int i = 0; i < n; i++) app->postIndexIds[i] = app->postIndex[i]->id;
+    app->post_index_count = n;
+    app->post_index_capacity = n + 1;
+    app->post_index_valid = true;
+}
+
+// [Kernel] Cari post berdasarkan ID lewat index (termasuk yang ber-tombstone)
+Post* find_post(AppState *app, int id) {
+    if (!app->post_index_valid) rebuild_post_index(app);
+    int i = lower_bound_int(app->postIndexIds, app->post_index_count, id);
+    if (i < app->post_index_count && app->postIndexIds[i] == id) return app->postIndex[i];
+    return NULL;
+}
+
+// ======================= Memory Report =========================
+
+typedef struct {
+    long used;
+    long capacity;
+} SlackStat;
+
+// [Memory] Catat pemakaian satu field string berukuran tetap
+void slack_add(SlackStat *st, const char *field, size_t capacity) {
+    st->used += strlen(field) + 1;
+    st->capacity += capacity;
+}
+
+// [Memory] Cetak satu baris statistik slack
+void slack_print(FILE *out, const char *name, SlackStat st) {
+    long slack = st.capacity - st.used;
+    fprintf(out, "  %-22s %12ld %12ld %12ld  %5.1f%%\n", name, st.used, st.capacity, slack,
+            st.capacity ? 100.0 * slack / st.capacity : 0.0);
+}
+
+// [Memory] Tulis laporan memori per struktur + slack field string ke out
+void write_memory_report(AppState *app, FILE *out) {
+    long total = 0, objects = 0;
+    fprintf(out, "==================[ Memory Report ]==================\n");
+    fprintf(out, "  %-22s %12s %12s\n", "Struktur", "Objek", "Bytes");
+    for (int t = 0; t < MEM_TYPES; t++) {
+        long bytes = __atomic_load_n(&mem_bytes[t], __ATOMIC_RELAXED);
+        long count = __atomic_load_n(&mem_objects[t], __ATOMIC_RELAXED);
+        fprintf(out, "  %-22s %12ld %12ld\n", mem_type_names[t], count, bytes);
+        total += bytes;
+        objects += count;
+    }
+    fprintf(out, "  %-22s %12ld %12ld\n", "Total", objects, total);
+    long headers = __atomic_load_n(&mem_header_objects, __ATOMIC_RELAXED);
+    fprintf(out, "  Overhead header alokasi: %ld bytes (%ld buffer variabel)\n", headers * (long)sizeof(MemHeader), headers);
+
+#ifndef _WIN32
+    // RSS proses (hanya tersedia di Linux), dikonversi dengan ukuran page sebenarnya
+    FILE *statm = fopen("/proc/self/statm", "r");
+    long pages_total, pages_resident;
+    if (statm) {
+        if (fscanf(statm, "%ld %ld", &pages_total, &pages_resident) == 2)
+            fprintf(out, "  RSS proses: %ld KB\n", pages_resident * (sysconf(_SC_PAGESIZE) / 1024));
+        fclose(statm);
+    }
+#endif
+
+    SlackStat username = {0}, email = {0}, password = {0}, media = {0}, text = {0}, msg = {0};
+    for (User *u = app->users; u; u = u->next) {
+        slack_add(&username, u->username, MAX_STRING);
+        slack_add(&email, u->email, MAX_STRING);
+        slack_add(&password, u->password, MAX_STRING);
+    }
+    for (Post *p = app->posts; p; p = p->next) {
+        slack_add(&media, p->media, MAX_STRING);
+    }
+    for (Comment *c = app->comments; c; c = c->next)
+        slack_add(&text, c->text, MAX_STRING);
+    for (NotifNode *nn = app->notifFront; nn; nn = nn->next)
+        slack_add(&msg, nn->msg, MAX_STRING * 2);
+    fprintf(out, "-------------[ Slack field string tetap ]-------------\n");
+    fprintf(out, "  %-22s %12s %12s %12s  %6s\n", "Field", "Terpakai", "Kapasitas", "Slack", "Slack");
+    slack_print(out, "User.username", username);
+    slack_print(out, "User.email", email);
+    slack_print(out, "User.password", password);
+    slack_print(out, "Post.media", media);
+    slack_print(out, "Comment.text", text);
+    slack_print(out, "NotifNode.msg", msg);
+    fprintf(out, "=====================================================\n");
+}
+
+// [Memory] Tampilkan laporan memori dan simpan ke memory.txt
+void show_memory_report(AppState *app) {
+    printf("\n");
+    write_memory_report(app, stdout);
+    FILE *file = fopen("memory.txt", "w");
+    if (file) {
+        write_memory_report(app, file);
+        fclose(file);
+        printf(">> Laporan disimpan ke memory.txt\n");
+    }
+}
+
+// ======================= Hashtag & Mention =========================
+// #tag dan @user diambil dari caption (create/edit) dan comment, lalu disimpan di index
+// tag -> daftar post. Hashtag trending dihitung dengan count-min sketch (conservative update)
+// + daftar kandidat heavy hitter berukuran tetap, sehingga memori dan waktu query top 20 konstan
+// berapa pun jumlah post. Hitungan dibagi dua setiap TREND_HALF_LIFE kemunculan agar trending
+// mengikuti aktivitas terbaru. Tag post cold dicatat ke cold.tags saat --archive-cold sehingga
+// bisa diindeks saat startup tanpa membuka segment. Index awal tidak dihitung ke trending:
+// trending hanya berisi aktivitas sejak aplikasi berjalan.
+
+#define TREND_DEPTH 4
+#define TREND_WIDTH 2048
+#define TREND_TOPK 64 // Kandidat heavy hitter (lebih dari 20 agar urutan top 20 stabil)
+#define TREND_HALF_LIFE 5000
+
+typedef struct {
+    char tag[TAG_MAX + 2];
+    unsigned count; // Estimasi count-min saat terakhir diperbarui
+} TrendItem;
+
+typedef struct TrendSketch {
+    unsigned cms[TREND_DEPTH][TREND_WIDTH];
+    TrendItem top[TREND_TOPK];
+    int top_count;
+    long events; // Kemunculan sejak pembagian dua terakhir
+    long half_life; // 0 = tanpa peluruhan
+} TrendSketch;
+
+// [Tag] Hash FNV-1a dengan seed (satu seed per baris sketch)
+unsigned long tag_hash(const char *tag, unsigned long seed) {
+    unsigned long h = 1469598103934665603UL ^ (seed * 0x9E3779B97F4A7C15UL);
+    for (; *tag; tag++) {
+        h ^= (unsigned char)*tag;
+        h *= 1099511628211UL;
+    }
+    return h ^ (h >> 29);
+}
+
+bool is_tag_char(char c) {
+    return isalnum((unsigned char)c) || c == '_';
+}
+
+// [Tag] Ambil token #tag/@user berikutnya dari *cursor ke out (huruf kecil). Return false jika habis
+bool next_tag_token(const char **cursor, const char *start, char *out) {
+    for (const char *q = *cursor; *q; q++) {
+        if ((*q != '#' && *q != '@') || !is_tag_char(q[1]) || (q > start && is_tag_char(q[-1])))
+            continue;
+        int n = 0;
+        out[n++] = *q;
+        for (q++; is_tag_char(*q); q++)
+            if (n <= TAG_MAX) out[n++] = tolower((unsigned char)*q);
+        out[n] = '\0';
+        *cursor = q;
+        return true;
+    }
+    return false;
+}
+
+// [Tag] Cari entry tag di hash table (buat baru jika create)
+TagEntry* find_tag(AppState *app, const char *tag, bool create) {
+    unsigned bucket = tag_hash(tag, 0) % TAG_BUCKETS;
+    for (TagEntry *e = app->tagBuckets[bucket]; e; e = e->hnext)
+        if (strcmp(e->tag, tag) == 0) return e;
+    if (!create) return NULL;
+    TagEntry *e = (TagEntry*)mem_calloc_sized(MEM_TAG_INDEX, sizeof(TagEntry));
+    strcpy(e->tag, tag);
+    e->hnext = app->tagBuckets[bucket];
+    app->tagBuckets[bucket] = e;
+    app->tag_count++;
+    return e;
+}
+
+// [Tag] Tambahkan post ke daftar tag (tetap terurut, tanpa duplikat)
+void tag_index_add(AppState *app, const char *tag, int post_id) {
+    TagEntry *e = find_tag(app, tag, true);
+    int i = lower_bound_int(e->post_ids, e->count, post_id);
+    if (i < e->count && e->post_ids[i] == post_id) return;
+    if (e->count == e->capacity) {
+        e->capacity = e->capacity ? e->capacity * 2 : 4;
+        e->post_ids = (int*)mem_realloc(MEM_TAG_INDEX, e->post_ids, sizeof(int) * e->capacity);
+    }
+    memmove(&e->post_ids[i + 1], &e->post_ids[i], sizeof(int) * (e->count - i));
+    e->post_ids[i] = post_id;
+    e->count++;
+}
+
+// [Tag] Hapus post dari daftar tag
+void tag_index_remove(AppState *app, const char *tag, int post_id) {
+    TagEntry *e = find_tag(app, tag, false);
+    if (!e) return;
+    int i = lower_bound_int(e->post_ids, e->count, post_id);
+    if (i == e->count || e->post_ids[i] != post_id) return;
+    memmove(&e->post_ids[i], &e->post_ids[i + 1], sizeof(int) * (e->count - i - 1));
+    e->count--;
+}
+
+// [Trend] Sketch milik app (dialokasikan sekali, ukuran tetap)
+TrendSketch* trend_sketch(AppState *app) {
+    if (!app->trend) {
+        app->trend = (TrendSketch*)mem_calloc_sized(MEM_TREND, sizeof(TrendSketch));
+        app->trend->half_life = TREND_HALF_LIFE;
+    }
+    return app->trend;
+}
+
+// [Trend] Estimasi count-min untuk tag (tidak pernah di bawah hitungan sebenarnya)
+unsigned trend_estimate(TrendSketch *ts, const char *tag) {
+    unsigned est = ~0u;
+    for (int d = 0; d < TREND_DEPTH; d++) {
+        unsigned v = ts->cms[d][tag_hash(tag, d + 1) % TREND_WIDTH];
+        if (v < est) est = v;
+    }
+    return est;
+}
+
+// [Trend] Catat satu kemunculan hashtag: update sketch lalu daftar kandidat heavy hitter
+void trend_add(TrendSketch *ts, const char *tag) {
+    unsigned *cells[TREND_DEPTH];
+    unsigned est = ~0u;
+    for (int d = 0; d < TREND_DEPTH; d++) {
+        cells[d] = &ts->cms[d][tag_hash(tag, d + 1) % TREND_WIDTH];
+        if (*cells[d] < est) est = *cells[d];
+    }
+    est++;
+    for (int d = 0; d < TREND_DEPTH; d++) // Conservative update: hanya naikkan cell yang di bawah estimasi baru
+        if (*cells[d] < est) *cells[d] = est;
+
+    int min_i = 0;
+    for (int i = 0; i < ts->top_count; i++) {
+        if (strcmp(ts->top[i].tag, tag) == 0) {
+            ts->top[i].count = est;
+            min_i = -1;
+            break;
+        }
+        if (ts->top[i].count < ts->top[min_i].count) min_i = i;
+    }
+    if (min_i >= 0) {
+        if (ts->top_count < TREND_TOPK) min_i = ts->top_count++;
+        else if (ts->top[min_i].count >= est) min_i = -1;
+        if (min_i >= 0) {
+            strcpy(ts->top[min_i].tag, tag);
+            ts->top[min_i].count = est;
+        }
+    }
+
+    if (ts->half_life && ++ts->events >= ts->half_life) { // Peluruhan: bagi dua semua hitungan
+        for (int d = 0; d < TREND_DEPTH; d++)
+            for (int w = 0; w < TREND_WIDTH; w++) ts->cms[d][w] >>= 1;
+        for (int i = 0; i < ts->top_count; i++) ts->top[i].count >>= 1;
+        ts->events = 0;
+    }
+}
+
+int cmp_trend_item(const void *a, const void *b) {
+    const TrendItem *x = (const TrendItem*)a, *y = (const TrendItem*)b;
+    if (x->count != y->count) return x->count < y->count ? 1 : -1;
+    return strcmp(x->tag, y->tag);
+}
+
+// [Trend] Salin k hashtag teratas ke out (terurut count turun). Return jumlah yang diisi
+int trend_top(TrendSketch *ts, TrendItem *out, int k) {
+    if (!ts) return 0;
+    TrendItem sorted[TREND_TOPK];
+    memcpy(sorted, ts->top, sizeof(TrendItem) * ts->top_count);
+    qsort(sorted, ts->top_count, sizeof(TrendItem), cmp_trend_item);
+    int n = 0;
+    for (int i = 0; i < ts->top_count && n < k; i++)
+        if (sorted[i].count > 0) out[n++] = sorted[i];
+    return n;
+}
+
+// [Tag] Index semua #tag/@user di text untuk post_id; hashtag juga dihitung ke trending jika trend
+void index_text_tags(AppState *app, int post_id, const char *text, bool trend) {
+    char tag[TAG_MAX + 2];
+    const char *cursor = text;
+    while (next_tag_token(&cursor, text, tag)) {
+        tag_index_add(app, tag, post_id);
+        if (trend && tag[0] == '#') trend_add(trend_sketch(app), tag);
+    }
+}
+
+// [Tag] Lepas semua #tag/@user di text dari daftar post_id
+void unindex_text_tags(AppState *app, int post_id, const char *text) {
+    char tag[TAG_MAX + 2];
+    const char *cursor = text;
+    while (next_tag_token(&cursor, text, tag))
+        tag_index_remove(app, tag, post_id);
+}
+
+// [Tag] Cek apakah text memuat token tag
+bool text_has_tag(const char *text, const char *tag) {
+    char other[TAG_MAX + 2];
+    const char *cursor = text;
+    while (next_tag_token(&cursor, text, other))
+        if (strcmp(other, tag) == 0) return true;
+    return false;
+}
+
+// [Tag] Caption post berubah: lepas tag caption lama, index caption baru + comment post tsb.
+// Hanya hashtag yang belum ada di caption lama yang dihitung ke trending
+void retag_post(AppState *app, Post *p, const char *old_caption) {
+    char tag[TAG_MAX + 2];
+    unindex_text_tags(app, p->id, old_caption);
+    const char *cursor = p->content;
+    while (next_tag_token(&cursor, p->content, tag)) {
+        tag_index_add(app, tag, p->id);
+        if (tag[0] == '#' && !text_has_tag(old_caption, tag)) trend_add(trend_sketch(app), tag);
+    }
+    for (Comment *c = app->comments; c; c = c->next) // Tag yang juga muncul di comment tetap terindeks
+        if (c->post_id == p->id) index_text_tags(app, p->id, c->text, false);
+}
+
+// [Tag] Index tag post cold dari cold.tags (baris "post_id|tag", ditulis --archive-cold)
+void load_cold_tags(AppState *app) {
+    FILE *file = fopen("cold.tags", "r");
+    if (!file) return;
+    int post_id;
+    char tag[TAG_MAX + 2];
+    while (fscanf(file, "%d|%51s\n", &post_id, tag) == 2) {
+        Post *p = find_post(app, post_id);
+        if (p && p->cold && !p->deleted) tag_index_add(app, tag, post_id);
+    }
+    fclose(file);
+}
+
+// [Tag] Bangun index tag dari post & comment yang sudah dimuat, plus tag post cold dari cold.tags.
+// Riwayat ini tidak dihitung ke trending
+void build_tag_index(AppState *app) {
+    for (Post *p = app->posts; p; p = p->next)
+        if (!p->cold && !p->deleted) index_text_tags(app, p->id, p->content, false);
+    for (Comment *c = app->comments; c; c = c->next)
+        index_text_tags(app, c->post_id, c->text, false);
+    load_cold_tags(app);
+}
+
+// [Tag] Bebaskan index tag dan sketch trending
+void free_tag_index(AppState *app) {
+    for (int b = 0; b < TAG_BUCKETS; b++) {
+        TagEntry *e = app->tagBuckets[b];
+        while (e) {
+            TagEntry *tmp = e;
+            e = e->hnext;
+            mem_free(MEM_TAG_INDEX, tmp->post_ids);
+            mem_free_sized(MEM_TAG_INDEX, tmp, sizeof(TagEntry));
+        }
+        app->tagBuckets[b] = NULL;
+    }
+    app->tag_count = 0;
+    mem_free_sized(MEM_TREND, app->trend, sizeof(TrendSketch));
+    app->trend = NULL;
+}
+
+// [Trend] Tampilkan top 20 hashtag
+void show_top_hashtags(AppState *app) {
+    TrendItem top[20];
+    int n = trend_top(app->trend, top, 20);
+    printf("\n=================[ Top 20 Hashtags ]=================\n");
+    if (n == 0) printf(">> Belum ada hashtag.\n");
+    for (int i = 0; i < n; i++)
+        printf("%2d. %-30s ~%u\n", i + 1, top[i].tag, top[i].count);
+    printf("=====================================================\n");
+}
+
+// [Tag] Tampilkan post yang memuat #tag atau @user tertentu
+void show_posts_by_tag(AppState *app) {
+    char input[MAX_STRING], tag[TAG_MAX + 2];
+    printf("Masukkan #tag atau @user: ");
+    scanf(" %99[^\n]", input);
+    const char *cursor = input;
+    if (!next_tag_token(&cursor, input, tag)) {
+        printf(">> Format harus #tag atau @user.\n");
+        return;
+    }
+    TagEntry *e = find_tag(app, tag, false);
+    int shown = 0;
+    printf("\n==================[ Post %s ]==================\n", tag);
+    for (int i = 0; e && i < e->count; i++) {
+        Post *p = find_post(app, e->post_ids[i]);
+        if (!p || p->deleted) continue;
+        printf("[%d] User %d: %s (%s) Likes: %d\n", p->id, p->user_id, post_caption(app, p), p->media, post_likes(p));
+        shown++;
+    }
+    if (shown == 0) printf(">> Tidak ada post dengan %s.\n", tag);
+    printf("=====================================================\n");
+}
+
+// --- Fitur ---
+// Function prototype for insert_user_bst
+UserBSTNode* insert_user_bst(UserBSTNode *root, User *user);
+
+int signup(AppState *app) {
+    User u;
+    u.id = app->user_count + 1;
+    printf("Username: ");
+    scanf(" %[^\n]", u.username);
+    printf("Email: ");
+    scanf(" %[^\n]", u.email);
+    printf("Password: ");
+    scanf(" %[^\n]", u.password);
+    u.next = NULL;
+    insert_user(app, u);
+    // Tambahkan baris berikut agar BST user ikut di-update
+    app->userBST = insert_user_bst(app->userBST, app->users); // app->users adalah user baru di head
+    save_users(app);
+    printf("Signup successful. Please login.\n");
+    return -1;
+}
+
+// Log user activity
+void log_activity(const char *msg) {
+    FILE *file = fopen("log.txt", "a");
+    if (file) {
+        fprintf(file, "%s\n", msg);
+        fclose(file);
+    }
+}
+
+// Function prototype for search_user_bst
+User* search_user_bst(UserBSTNode *root, const char *username);
+
+// Login
+int login(AppState *app) {
+    char uname[MAX_STRING], pass[MAX_STRING];
+    printf("Username: ");
+    scanf(" %[^\n]", uname);
+    printf("Password: ");
+    scanf(" %[^\n]", pass);
+    User *u = search_user_bst(app->userBST, uname);
+    if (u && strcmp(u->password, pass) == 0) {
+        printf("Login successful!\n");
+        char logmsg[MAX_STRING * 2];
+        snprintf(logmsg, sizeof(logmsg), "User %s logged in.", uname);
+        log_activity(logmsg);
+        return u->id;
+    }
+    printf("Login failed.\n");
+    return -1;
+}
+
+// Create post
+// [Linked List] Alokasikan ID post berikutnya (pada shard: ID yang jatuh ke shard ini)
+int next_post_id(AppState *app) {
+    int id = app->last_post_id + 1;
+    if (app->shard_count > 1)
+        while (id % app->shard_count != app->shard_index) id++;
+    app->last_post_id = id;
+    return id;
+}
+
+// [Linked List] Tambah post baru milik user_id lalu simpan ke file
+Post* add_post(AppState *app, int user_id, const char *media, const char *caption) {
+    Post p = {0};
+    p.id = next_post_id(app);
+    p.user_id = user_id;
+    strncpy(p.media, media, MAX_STRING - 1);
+    set_post_caption(&p, caption);
+    insert_post(app, p);
+    index_text_tags(app, p.id, caption, true);
+    save_posts(app);
+    return app->posts;
+}
+
+void create_post(AppState *app) {
+    char media[MAX_STRING], caption[MAX_STRING];
+    printf("Media Filename (png, jpg, etc): ");
+    scanf(" %[^\n]", media);
+    printf("Caption: ");
+    scanf(" %[^\n]", caption);
+    add_post(app, app->current_user_id, media, caption);
+    printf("Post created.\n");
+}
+
+// View posts
+// [Render] Tulis daftar post ke out (tiap blok post diambil dari cache render)
+void write_posts_view(AppState *app, FILE *out) {
+    int n = 0;
+    Post *p = app->posts;
+    while (p) { if (!p->deleted) n++; p = p->next; }
+    if (n == 0) {
+        fprintf(out, "\n>> Belum ada postingan.\n");
+        return;
+    }
+    Post **arr = (Post**)malloc(sizeof(Post*) * n);
+    n = 0;
+    for (p = app->posts; p; p = p->next)
+        if (!p->deleted) arr[n++] = p;
+    radix_sort_posts_by_id(arr, n);
+    fprintf(out, "\n====================[ Daftar Postingan ]====================\n");
+    for (int i = 0; i < n; i++)
+        write_cached_post(app, arr[i], out);
+    fprintf(out, "\n============================================================\n");
+    free(arr);
+}
+
+void view_posts(AppState *app) {
+    write_posts_view(app, stdout);
+}
+
+// [Linked List] Like post
+void like_post(AppState *app) {
+    int pid;
+    printf("Enter post ID to like: ");
+    scanf("%d", &pid);
+    Post *p = find_post(app, pid);
+    if (p && !p->deleted) {
+        if (!post_add_like(p, app->current_user_id)) {
+            printf("Anda sudah like post ini.\n");
+            return;
+        }
+        save_posts(app); // (opsional: simpan liker ke file jika ingin persistent)
+        printf("Post liked!\n");
+        char notif[MAX_STRING * 2];
+        snprintf(notif, sizeof(notif), "You liked post ID %d", p->id);
+        enqueueNotif(app, notif, p->id);
+        return;
+    }
+    printf("Post not found.\n");
+}
+
+// [Linked List] Unlike post
+void unlike_post(AppState *app) {
+    int pid;
+    printf("\nEnter post ID to unlike: ");
+    scanf("%d", &pid);
+    Post *p = find_post(app, pid);
+    if (p && !p->deleted) {
+        if (post_remove_like(p, app->current_user_id)) {
+            save_posts(app);
+            printf("Post unliked!\n");
+            char notif[MAX_STRING * 2];
+            snprintf(notif, sizeof(notif), "You unliked post ID %d", p->id);
+            enqueueNotif(app, notif, p->id);
+            return;
+        }
+        // Jika user ini tidak ada di set liker
+        printf("Anda belum like post ini.\n");
+        return;
+    }
+    printf("Post not found.\n");
+}
+
+// [Linked List] Comment post
+void comment_post(AppState *app) {
+    int pid;
+    Comment c;
+    printf("Enter post ID to comment: ");
+    scanf("%d", &pid);
+    Post *target = find_post(app, pid);
+    if (!target || target->deleted) { // Comment ke post yang tidak ada akan menempel ke post baru ber-ID sama
+        printf("Post not found.\n");
+        return;
+    }
+    c.id = ++app->last_comment_id;
+    c.user_id = app->current_user_id;
+    c.post_id = pid;
+    printf("Comment: ");
+    scanf(" %[^\n]", c.text);
+    c.next = NULL;
+    insert_comment(app, c);
+    index_text_tags(app, pid, c.text, true);
+    render_cache_touch(target);
+    save_comments(app);
+    printf("Comment added.\n");
+    char notif[MAX_STRING * 2];
+    snprintf(notif, sizeof(notif), "You commented on post ID %d", pid);
+    enqueueNotif(app, notif, pid);
+}
+
+// [Linked List & Stack] Delete post (tulis tombstone, push ke undo stack)
+// Comment, like, index dan notifikasi post ini direklamasi belakangan oleh compact_step
+void delete_post(AppState *app) {
+    int pid;
+    printf("Enter post ID to delete: ");
+    scanf("%d", &pid);
+
+    Post *p = find_post(app, pid);
+    if (p && p->user_id == app->current_user_id && !p->deleted) {
+        p->deleted = true;
+        p->deleted_seq = app->action_seq;
+        app->tombstones++;
+        app->post_count--;
+        pushUndo(app, p);
+        render_cache_drop(app, p->id);
+        save_posts(app);
+        printf("Post deleted. (Undo available)\n");
+        char notif[MAX_STRING * 2];
+        snprintf(notif, sizeof(notif), "You deleted post ID %d", pid);
+        enqueueNotif(app, notif, 0);
+        return;
+    }
+    printf("Post not found or you are not the owner.\n");
+}
+
+// [Linked List] Edit post
+void edit_post(AppState *app) {
+    int pid;
+    printf("Enter post ID to edit: ");
+    scanf("%d", &pid);
+    Post *p = find_post(app, pid);
+    if (p && p->user_id == app->current_user_id && !p->deleted) {
+        if (p->cold) {
+            if (!warm_post(app, p)) {
+                printf("Data post tidak bisa dimuat dari segment cold.\n");
+                return;
+            }
+            save_comments(app);
+        }
+        char old_caption[MAX_STRING], caption[MAX_STRING];
+        strcpy(old_caption, p->content);
+        printf("New Media Filename (png, jpg, etc): ");
+        scanf(" %[^\n]", p->media);
+        printf("New Caption: ");
+        scanf(" %99[^\n]", caption);
+        set_post_caption(p, caption);
+        retag_post(app, p, old_caption);
+        render_cache_touch(p);
+        save_posts(app);
+        printf("Post updated.\n");
+        return;
+    }
+    printf("Post not found or unauthorized.\n");
+}
+
+// [Heap] Tampilkan top 3 post by likes
+void sort_and_show_posts_by_likes(AppState *app) {
+    if (!app->posts) {
+        printf("No posts.\n");
+        return;
+    }
+    PostHeap heap;
+    build_post_heap(&heap, app->posts);
+    printf("Top 3 Posts by Likes:\n");
+    for (int i = 0; i < 3 && heap.size > 0; i++) {
+        Post *p = extract_max(&heap);
+        printf("[%d] User %d: %s (%s) Likes: %d\n", p->id, p->user_id, post_caption(app, p), p->media, post_likes(p));
+    }
+    free_post_heap(&heap);
+}
+
+// [Kernel] Tampilkan semua post, diranking berdasarkan likes (seri: ID naik)
+void show_all_posts_ranked(AppState *app) {
+    int n = 0;
+    for (Post *p = app->posts; p; p = p->next)
+        if (!p->deleted) n++;
+    if (n == 0) {
+        printf("No posts.\n");
+        return;
+    }
+    Post **arr = (Post**)malloc(sizeof(Post*) * n);
+    n = 0;
+    for (Post *p = app->posts; p; p = p->next)
+        if (!p->deleted) arr[n++] = p;
+    radix_rank_posts_by_likes(arr, n);
+    printf("\n=================[ Semua Post by Likes ]=================\n");
+    for (int i = 0; i < n; i++)
+        printf("%d. [%d] User %d: %s (%s) Likes: %d\n", i + 1, arr[i]->id, arr[i]->user_id,
+               post_caption(app, arr[i]), arr[i]->media, post_likes(arr[i]));
+    printf("=========================================================\n");
+    free(arr);
+}
+
+// [Stack] Undo delete post
+void undo_delete_post(AppState *app) {
+    if (isUndoEmpty(app)) {
+        printf("No post to undo.\n");
+        return;
+    }
+    Post *live;
+    Post p = popUndo(app, &live);
+    if (p.id == 0) {
+        printf("No valid post to restore.\n");
+        return;
+    }
+    if (live) {
+        // Belum direklamasi: cukup hapus tombstone
+        live->deleted = false;
+        app->tombstones--;
+        app->post_count++;
+        drop_post_caption(&p);
+    } else {
+        // Sudah direklamasi: selesaikan sweep dulu, lalu pulihkan isi post (comment sudah hilang)
+        compact_finish_cycle(app);
+        insert_post(app, p);
+    }
+    save_posts(app);
+    printf("Undo successful. Post restored!\n");
+    char notif[MAX_STRING * 2];
+    snprintf(notif, sizeof(notif), "You restored post ID %d", p.id);
+    enqueueNotif(app, notif, 0);
+}
+
+// [Kernel] Search post by ID (lower bound pada index ID post)
+void search_post_by_id(AppState *app) {
+    if (!app->posts) {
+        printf("No posts.\n");
+        return;
+    }
+    int id;
+    printf("Masukkan ID post yang dicari: ");
+    scanf("%d", &id);
+
+    Post *found = find_post(app, id);
+    if (found && !found->deleted)
+        printf("Ditemukan: [%d] %s Likes: %d\n", found->id, post_caption(app, found), post_likes(found));
+    else
+        printf("Post dengan ID %d tidak ditemukan.\n", id);
+}
+
+// [BST/Linked List] Search post by username/ID
+void search_post(AppState *app) {
+    int opsi;
+    printf("Cari post berdasarkan:\n1. Username\n2. ID\nPilih: ");
+    scanf("%d", &opsi);
+    getchar(); // flush newline
+    if (opsi == 1) {
+        char uname[MAX_STRING];
+        printf("Masukkan username: ");
+        fgets(uname, sizeof(uname), stdin);
+        uname[strcspn(uname, "\n")] = 0;
+        int uid = -1;
+        User *u = app->users;
+        while (u) {
+            if (strcmp(u->username, uname) == 0) {
+                uid = u->id;
+                break;
+            }
+            u = u->next;
+        }
+        if (uid == -1) {
+            printf("Username tidak ditemukan.\n");
+            return;
+        }
+        Post *p = app->posts;
+        int found = 0;
+        while (p) {
+            if (p->user_id == uid && !p->deleted) {
+                printf("[%d] %s (%s) Likes: %d\n", p->id, post_caption(app, p), p->media, post_likes(p));
+                found = 1;
+            }
+            p = p->next;
+        }
+        if (!found) printf("Tidak ada post dari user ini.\n");
+    } else if (opsi == 2) {
+        search_post_by_id(app);
+    } else {
+        printf("Pilihan tidak valid.\n");
+    }
+}
+
+// [Menu] Menu user setelah login
+void user_menu(AppState *app); // Function prototype
+
+// [Menu] Menu utama aplikasi
+void main_menu(AppState *app) {
+    int choice;
+    do {
+        printf("\n=====================================================\n");
+        printf("                SELAMAT DATANG DI INSTAGRAM          \n");
+        printf("=====================================================\n");
+        printf("  1. Sign Up\n");
+        printf("  2. Log In\n");
+        printf("  3. Exit\n");
+        printf("-----------------------------------------------------\n");
+        printf("Pilih menu (1-3): ");
+        scanf("%d", &choice);
+        printf("=====================================================\n");
+        switch (choice) {
+            case 1: signup(app); break;
+            case 2:
+                app->current_user_id = login(app);
+                if (app->current_user_id != -1) user_menu(app);
+                break;
+            case 3: 
+                compact_all(app);
+                printf("\nTerima kasih telah menggunakan aplikasi!\n\n");
+                exit(0);
+            default: printf(">> Pilihan tidak valid!\n");
+        }
+    } while (1);
+}
+
+// [Menu] Menu user setelah login
+void user_menu(AppState *app) {
+    int choice;
+    do {
+        printf("\n=====================================================\n");
+        printf("                    USER MENU                        \n");
+        printf("=====================================================\n");
+        printf("  1.  Create Post\n");
+        printf("  2.  View Posts\n");
+        printf("  3.  Like Post\n");
+        printf("  4.  Unlike Post\n");
+        printf("  5.  Comment Post\n");
+        printf("  6.  Delete Post\n");
+        printf("  7.  Edit Post\n");
+        printf("  8.  Search Post\n");
+        printf("  9.  View Posts by Likes\n");
+        printf(" 10.  View All Posts Ranked by Likes\n");
+        printf(" 11.  Undo Delete Post\n");
+        printf(" 12.  Show Notifications\n");
+        printf(" 13.  Storage Status\n");
+        printf(" 14.  Memory Report\n");
+        printf(" 15.  Top 20 Hashtags\n");
+        printf(" 16.  Posts by #Tag / @User\n");
+        printf(" 17.  Log Out\n");
+        printf("-----------------------------------------------------\n");
+        printf("Pilih menu (1-17): ");
+        scanf("%d", &choice);
+        printf("=====================================================\n");
+        switch (choice) {
+            case 1: create_post(app); break;
+            case 2: view_posts(app); break;
+            case 3: like_post(app); break;
+            case 4: unlike_post(app); break;
+            case 5: comment_post(app); break;
+            case 6: delete_post(app); break;
+            case 7: edit_post(app); break;
+            case 8: search_post(app); break;
+            case 9: sort_and_show_posts_by_likes(app); break;
+            case 10: show_all_posts_ranked(app); break;
+            case 11: undo_delete_post(app); break;
+            case 12: showNotifications(app); break;
+            case 13: show_storage_status(app); break;
+            case 14: show_memory_report(app); break;
+            case 15: show_top_hashtags(app); break;
+            case 16: show_posts_by_tag(app); break;
+            case 17:
+                compact_all(app);
+                return;
+            default: printf(">> Pilihan tidak valid!\n");
+        }
+        app->action_seq++;
+        compact_step(app, COMPACT_BUDGET);
+    } while (1);
+}
+
+void bubble_sort_posts_by_id(Post **arr, int n) {
+    for (int i = 0; i < n-1; i++)
+        for (int j = 0; j < n-i-1; j++)
+            if (arr[j]->id > arr[j+1]->id) {
+                Post *tmp = arr[j];
+                arr[j] = arr[j+1];
+                arr[j+1] = tmp;
+            }
+}
+
+void quick_sort_posts(Post **arr, int left, int right) {
+    if (left >= right) return;
+    int i = left, j = right;
+    int pivot = post_likes(arr[(left + right) / 2]);
+    while (i <= j) {
+        while (post_likes(arr[i]) > pivot) i++;
+        while (post_likes(arr[j]) < pivot) j--;
+        if (i <= j) {
+            Post *tmp = arr[i];
+            arr[i] = arr[j];
+            arr[j] = tmp;
+            i++; j--;
+        }
+    }
+    if (left < j) quick_sort_posts(arr, left, j);
+    if (i < right) quick_sort_posts(arr, i, right);
+}
+
+// [Searching: Binary Search] Binary search array post by ID
+int binary_search_post(Post **arr, int n, int id) {
+    int left = 0, right = n - 1;
+    while (left <= right) {
+        int mid = left + (right - left) / 2;
+        if (arr[mid]->id == id) return mid;
+        if (arr[mid]->id < id) left = mid + 1;
+        else right = mid - 1;
+    }
+    return -1;
+}
+
+// Tambahkan struct BST untuk User
+/* Duplicate definition of UserBSTNode removed */
+
+// [BST] Insert user ke BST User
+UserBSTNode* insert_user_bst(UserBSTNode *root, User *user) {
+    if (!root) {
+        UserBSTNode *node = (UserBSTNode*)mem_alloc_sized(MEM_USER_BST, sizeof(UserBSTNode));
+        node->user = user;
+        node->left = node->right = NULL;
+        return node;
+    }
+    if (strcmp(user->username, root->user->username) < 0)
+        root->left = insert_user_bst(root->left, user);
+    else if (strcmp(user->username, root->user->username) > 0)
+        root->right = insert_user_bst(root->right, user);
+    return root;
+}
+
+// [BST] Cari user pada BST User berdasarkan username
+User* search_user_bst(UserBSTNode *root, const char *username) {
+    if (!root) return NULL;
+    int cmp = strcmp(username, root->user->username);
+    if (cmp == 0) return root->user;
+    if (cmp < 0) return search_user_bst(root->left, username);
+    else return search_user_bst(root->right, username);
+}
+
+// Tambahkan struct BST untuk Comment
+
+// [BST] Insert comment ke BST Comment
+CommentBSTNode* insert_comment_bst(CommentBSTNode *root, Comment *comment) {
+    if (!root) {
+        CommentBSTNode *node = (CommentBSTNode*)mem_alloc_sized(MEM_COMMENT_BST, sizeof(CommentBSTNode));
+        node->comment = comment;
+        node->left = node->right = NULL;
+        return node;
+    }
+    if (comment->id < root->comment->id)
+        root->left = insert_comment_bst(root->left, comment);
+    else if (comment->id > root->comment->id)
+        root->right = insert_comment_bst(root->right, comment);
+    return root;
+}
+
+// [BST] Hapus comment dari BST Comment berdasarkan ID
+CommentBSTNode* delete_comment_bst(CommentBSTNode *root, int id) {
+    if (!root) return NULL;
+    if (id < root->comment->id)
+        root->left = delete_comment_bst(root->left, id);
+    else if (id > root->comment->id)
+        root->right = delete_comment_bst(root->right, id);
+    else {
+        if (!root->left || !root->right) {
+            CommentBSTNode *child = root->left ? root->left : root->right;
+            mem_free_sized(MEM_COMMENT_BST, root, sizeof(CommentBSTNode));
+            return child;
+        }
+        CommentBSTNode *succ = root->right;
+        while (succ->left) succ = succ->left;
+        root->comment = succ->comment;
+        root->right = delete_comment_bst(root->right, succ->comment->id);
+    }
+    return root;
+}
+
+// [BST] Cari comment pada BST Comment berdasarkan ID
+Comment* search_comment_bst(CommentBSTNode *root, int id) {
+    if (!root) return NULL;
+    if (id == root->comment->id) return root->comment;
+    if (id < root->comment->id) return search_comment_bst(root->left, id);
+    else return search_comment_bst(root->right, id);
+}
+
+// ======================= Bulk Loader (Balanced Index) =========================
+// Index dibangun bottom-up dari array terurut: elemen tengah menjadi root, O(n).
+// File data biasanya sudah urut ID (naik, atau turun karena insert di head),
+// jadi pengurutan hanya dilakukan bila input memang acak.
+
+int cmp_post_ptr_id(const void *a, const void *b) {
+    const Post *x = *(Post* const*)a, *y = *(Post* const*)b;
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+int cmp_user_ptr_name(const void *a, const void *b) {
+    return strcmp((*(User* const*)a)->username, (*(User* const*)b)->username);
+}
+
+int cmp_comment_ptr_id(const void *a, const void *b) {
+    const Comment *x = *(Comment* const*)a, *y = *(Comment* const*)b;
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+// [Bulk] Pastikan array pointer terurut naik: O(n) jika sudah urut naik/turun, selain itu qsort
+void bulk_sort_ptrs(void **arr, int n, int (*cmp)(const void*, const void*)) {
+    bool asc = true, desc = true;
+    for (int i = 1; i < n && (asc || desc); i++) {
+        int c = cmp(&arr[i-1], &arr[i]);
+        if (c > 0) asc = false;
+        if (c < 0) desc = false;
+    }
+    if (asc) return;
+    if (desc) {
+        for (int i = 0, j = n - 1; i < j; i++, j--) {
+            void *tmp = arr[i];
+            arr[i] = arr[j];
+            arr[j] = tmp;
+        }
+        return;
+    }
+    qsort(arr, n, sizeof(void*), cmp);
+}
+
+// [Bulk] Build BST Post seimbang dari arr[lo..hi] yang terurut
+PostBSTNode* build_balanced_post_bst(Post **arr, int lo, int hi) {
+    if (lo > hi) return NULL;
+    int mid = lo + (hi - lo) / 2;
+    PostBSTNode *node = (PostBSTNode*)mem_alloc_sized(MEM_POST_BST, sizeof(PostBSTNode));
+    node->post = arr[mid];
+    node->left = build_balanced_post_bst(arr, lo, mid - 1);
+    node->right = build_balanced_post_bst(arr, mid + 1, hi);
+    return node;
+}
+
+// [Bulk] Build BST User seimbang dari arr[lo..hi] yang terurut (username)
+UserBSTNode* build_balanced_user_bst(User **arr, int lo, int hi) {
+    if (lo > hi) return NULL;
+    int mid = lo + (hi - lo) / 2;
+    UserBSTNode *node = (UserBSTNode*)mem_alloc_sized(MEM_USER_BST, sizeof(UserBSTNode));
+    node->user = arr[mid];
+    node->left = build_balanced_user_bst(arr, lo, mid - 1);
+    node->right = build_balanced_user_bst(arr, mid + 1, hi);
+    return node;
+}
+
+// [Bulk] Build BST Comment seimbang dari arr[lo..hi] yang terurut
+CommentBSTNode* build_balanced_comment_bst(Comment **arr, int lo, int hi) {
+    if (lo > hi) return NULL;
+    int mid = lo + (hi - lo) / 2;
+    CommentBSTNode *node = (CommentBSTNode*)mem_alloc_sized(MEM_COMMENT_BST, sizeof(CommentBSTNode));
+    node->comment = arr[mid];
+    node->left = build_balanced_comment_bst(arr, lo, mid - 1);
+    node->right = build_balanced_comment_bst(arr, mid + 1, hi);
+    return node;
+}
+
+// [Bulk] Build BST Post seimbang dari linked list Post
+PostBSTNode* bulk_build_post_bst(Post *head) {
+    int n = 0;
+    for (Post *p = head; p; p = p->next) n++;
+    if (n == 0) return NULL;
+    Post **arr = (Post**)malloc(sizeof(Post*) * n);
+    n = 0;
+    for (Post *p = head; p; p = p->next)
+        if (!p->deleted) arr[n++] = p;
+    bulk_sort_ptrs((void**)arr, n, cmp_post_ptr_id);
+    PostBSTNode *root = build_balanced_post_bst(arr, 0, n - 1);
+    free(arr);
+    return root;
+}
+
+// [Bulk] Build BST User seimbang dari linked list User
+UserBSTNode* bulk_build_user_bst(User *head) {
+    int n = 0;
+    for (User *u = head; u; u = u->next) n++;
+    if (n == 0) return NULL;
+    User **arr = (User**)malloc(sizeof(User*) * n);
+    n = 0;
+    for (User *u = head; u; u = u->next) arr[n++] = u;
+    bulk_sort_ptrs((void**)arr, n, cmp_user_ptr_name);
+    // Username duplikat: cukup satu entry di index, sama seperti insert_user_bst
+    int m = 0;
+    for (int i = 0; i < n; i++)
+        if (m == 0 || strcmp(arr[m-1]->username, arr[i]->username) != 0)
+            arr[m++] = arr[i];
+    UserBSTNode *root = build_balanced_user_bst(arr, 0, m - 1);
+    free(arr);
+    return root;
+}
+
+// [Bulk] Build BST Comment seimbang dari linked list Comment
+CommentBSTNode* bulk_build_comment_bst(Comment *head) {
+    int n = 0;
+    for (Comment *c = head; c; c = c->next) n++;
+    if (n == 0) return NULL;
+    Comment **arr = (Comment**)malloc(sizeof(Comment*) * n);
+    n = 0;
+    for (Comment *c = head; c; c = c->next) arr[n++] = c;
+    bulk_sort_ptrs((void**)arr, n, cmp_comment_ptr_id);
+    int m = 0;
+    for (int i = 0; i < n; i++)
+        if (m == 0 || arr[m-1]->id != arr[i]->id)
+            arr[m++] = arr[i];
+    CommentBSTNode *root = build_balanced_comment_bst(arr, 0, m - 1);
+    free(arr);
+    return root;
+}
+
+// [BST] Bebaskan seluruh node BST User
+void free_user_bst(UserBSTNode *root) {
+    if (!root) return;
+    free_user_bst(root->left);
+    free_user_bst(root->right);
+    mem_free_sized(MEM_USER_BST, root, sizeof(UserBSTNode));
+}
+
+// [BST] Bebaskan seluruh node BST Comment
+void free_comment_bst(CommentBSTNode *root) {
+    if (!root) return;
+    free_comment_bst(root->left);
+    free_comment_bst(root->right);
+    mem_free_sized(MEM_COMMENT_BST, root, sizeof(CommentBSTNode));
+}
+
+// [Bulk] Bangun semua index (User & Comment) sekaligus setelah load
+void bulk_build_indexes(AppState *app) {
+    app->userBST = bulk_build_user_bst(app->users);
+    app->commentBST = bulk_build_comment_bst(app->comments);
+    build_tag_index(app);
+}
+
+// [Heap berdasarkan jumlah post user
+typedef struct {
+    User **arr;
+    int size;
+    int capacity;
+} UserHeap;
+
+// Implementasi heapify dan build heap mirip PostHeap, tapi berdasarkan jumlah post user
+
+// [Linked List] Free semua alokasi memori
+void free_all(AppState *app) {
+    // Free users
+    User *u = app->users;
+    while (u) {
+        User *tmp = u;
+        u = u->next;
+        mem_free_sized(MEM_USER, tmp, sizeof(User));
+    }
+    // Free posts
+    Post *p = app->posts;
+    while (p) {
+        Post *tmp = p;
+        p = p->next;
+        free_post_likes(tmp);
+        drop_post_caption(tmp);
+        mem_free_sized(MEM_POST, tmp, sizeof(Post));
+    }
+    // Free comments
+    Comment *c = app->comments;
+    while (c) {
+        Comment *tmp = c;
+        c = c->next;
+        mem_free_sized(MEM_COMMENT, tmp, sizeof(Comment));
+    }
+    // Free undo stack
+    UndoNode *un = app->undoTop;
+    while (un) {
+        UndoNode *tmp = un;
+        un = un->next;
+        drop_post_caption(&tmp->post);
+        mem_free_sized(MEM_UNDO, tmp, sizeof(UndoNode));
+    }
+    // Free index & cache segment cold, cache render
+    free_cold_storage(app);
+    free_render_cache(app);
+    free_tag_index(app);
+    // Free index BST
+    free_user_bst(app->userBST);
+    free_comment_bst(app->commentBST);
+    app->userBST = NULL;
+    app->commentBST = NULL;
+    mem_free(MEM_COMPACTOR, app->deadIds);
+    app->deadIds = NULL;
+    mem_free(MEM_POST_INDEX, app->postIndex);
+    mem_free(MEM_POST_INDEX, app->postIndexIds);
+    app->postIndex = NULL;
+    app->postIndexIds = NULL;
+    app->post_index_count = app->post_index_capacity = 0;
+    app->post_index_valid = false;
+    // Free notifications queue
+    NotifNode *nn = app->notifFront;
+    while (nn) {
+        NotifNode *tmp = nn;
+        nn = nn->next;
+        mem_free_sized(MEM_NOTIF, tmp, sizeof(NotifNode));
+    }
+}
+
+// ======================= Export (JSON Lines / CSV) =========================
+#define EXPORT_BUFFER (1 << 20) // Output ditampung lalu ditulis sekali per chunk
+
+typedef struct {
+    char *data;
+    size_t len;
+    FILE *out;
+    long long written;
+} OutBuf;
+
+typedef struct {
+    int author; // 0 = semua author
+    int min_id, max_id;
+    int min_likes;
+} ExportFilter;
+
+// [Tools] Waktu monotonic dalam detik (untuk benchmark & statistik)
+double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// [Export] Tulis isi buffer ke file dalam satu fwrite
+void outbuf_flush(OutBuf *b) {
+    if (b->len) fwrite(b->data, 1, b->len, b->out);
+    b->written += b->len;
+    b->len = 0;
+}
+
+// [Export] Tambah byte ke buffer
+void outbuf_put(OutBuf *b, const char *s, size_t n) {
+    if (b->len + n > EXPORT_BUFFER) outbuf_flush(b);
+    if (n > EXPORT_BUFFER) {
+        fwrite(s, 1, n, b->out);
+        b->written += n;
+        return;
+    }
+    memcpy(b->data + b->len, s, n);
+    b->len += n;
+}
+
+void outbuf_str(OutBuf *b, const char *s) {
+    outbuf_put(b, s, strlen(s));
+}
+
+// [Export] Tulis bilangan bulat tanpa printf
+void outbuf_int(OutBuf *b, long v) {
+    char tmp[24];
+    int i = sizeof(tmp);
+    unsigned long u = v < 0 ? -(unsigned long)v : (unsigned long)v;
+    do { tmp[--i] = '0' + u % 10; u /= 10; } while (u);
+    if (v < 0) tmp[--i] = '-';
+    outbuf_put(b, tmp + i, sizeof(tmp) - i);
+}
+
+// [Export] Tulis string JSON (dengan quote & escape)
+void outbuf_json_str(OutBuf *b, const char *s) {
+    outbuf_put(b, "\"", 1);
+    const char *run = s;
+    for (; *s; s++) {
+        unsigned char c = *s;
+        if (c != '"' && c != '\\' && c >= 0x20) continue;
+        outbuf_put(b, run, s - run);
+        char esc[8];
+        if (c == '"') outbuf_put(b, "\\\"", 2);
+        else if (c == '\\') outbuf_put(b, "\\\\", 2);
+        else {
+            snprintf(esc, sizeof(esc), "\\u%04x", c);
+            outbuf_put(b, esc, 6);
+        }
+        run = s + 1;
+    }
+    outbuf_put(b, run, s - run);
+    outbuf_put(b, "\"", 1);
+}
+
+// [Export] Tulis field CSV (di-quote jika berisi koma, quote, atau newline)
+void outbuf_csv_str(OutBuf *b, const char *s) {
+    if (!strpbrk(s, ",\"\r\n")) {
+        outbuf_str(b, s);
+        return;
+    }
+    outbuf_put(b, "\"", 1);
+    for (const char *q; (q = strchr(s, '"')); s = q + 1) {
+        outbuf_put(b, s, q - s + 1);
+        outbuf_put(b, "\"", 1);
+    }
+    outbuf_str(b, s);
+    outbuf_put(b, "\"", 1);
+}
+
+// [Export] Cek filter post
+bool export_match(const ExportFilter *f, Post *p) {
+    return !p->deleted
+        && (!f->author || p->user_id == f->author)
+        && p->id >= f->min_id && p->id <= f->max_id
+        && post_likes(p) >= f->min_likes;
+}
+
+// [Export] Tulis satu comment sebagai elemen JSON atau baris CSV
+void export_comment(OutBuf *b, bool csv, bool first, const Comment *c) {
+    if (csv) {
+        outbuf_str(b, "comment,");
+        outbuf_int(b, c->post_id);
+        outbuf_put(b, ",", 1);
+        outbuf_int(b, c->id);
+        outbuf_put(b, ",", 1);
+        outbuf_int(b, c->user_id);
+        outbuf_str(b, ",,");
+        outbuf_csv_str(b, c->text);
+        outbuf_str(b, ",\n");
+        return;
+    }
+    outbuf_str(b, first ? "{\"id\":" : ",{\"id\":");
+    outbuf_int(b, c->id);
+    outbuf_str(b, ",\"user_id\":");
+    outbuf_int(b, c->user_id);
+    outbuf_str(b, ",\"text\":");
+    outbuf_json_str(b, c->text);
+    outbuf_put(b, "}", 1);
+}
+
+// Function prototype for cmp_comment_ptr_post
+int cmp_comment_ptr_post(const void *a, const void *b);
+
+// [Export] Stream post (urut ID) beserta comment & jumlah like ke file/pipe ("-" = stdout)
+int export_posts(const char *format, const char *path, ExportFilter filter) {
+    bool csv;
+    if (strcmp(format, "csv") == 0) csv = true;
+    else if (strcmp(format, "jsonl") == 0) csv = false;
+    else {
+        fprintf(stderr, "Format tidak dikenal: %s (jsonl|csv)\n", format);
+        return 1;
+    }
+    FILE *out = strcmp(path, "-") == 0 ? stdout : fopen(path, "wb");
+    if (!out) {
+        fprintf(stderr, "Tidak bisa menulis %s\n", path);
+        return 1;
+    }
+    double start = now_seconds();
+    AppState app = {0};
+    load_posts(&app);
+    load_comments(&app);
+    load_cold_index(&app);
+
+    Post **posts = (Post**)malloc(sizeof(Post*) * (app.post_count + 1));
+    int n = 0;
+    for (Post *p = app.posts; p; p = p->next) posts[n++] = p;
+    bulk_sort_ptrs((void**)posts, n, cmp_post_ptr_id);
+    Comment **comments = (Comment**)malloc(sizeof(Comment*) * (app.comment_count + 1));
+    int m = 0;
+    for (Comment *c = app.comments; c; c = c->next) comments[m++] = c;
+    qsort(comments, m, sizeof(Comment*), cmp_comment_ptr_post);
+
+    OutBuf b = { (char*)malloc(EXPORT_BUFFER), 0, out, 0 };
+    if (csv) outbuf_str(&b, "type,post_id,id,user_id,likes,text,media\n");
+    long exported = 0;
+    int ci = 0;
+    for (int i = 0; i < n; i++) {
+        Post *p = posts[i];
+        while (ci < m && comments[ci]->post_id < p->id) ci++;
+        if (!export_match(&filter, p)) continue;
+        if (csv) {
+            outbuf_str(&b, "post,");
+            outbuf_int(&b, p->id);
+            outbuf_put(&b, ",", 1);
+            outbuf_int(&b, p->id);
+            outbuf_put(&b, ",", 1);
+            outbuf_int(&b, p->user_id);
+            outbuf_put(&b, ",", 1);
+            outbuf_int(&b, post_likes(p));
+            outbuf_put(&b, ",", 1);
+            outbuf_csv_str(&b, post_caption(&app, p));
+            outbuf_put(&b, ",", 1);
+            outbuf_csv_str(&b, p->media);
+            outbuf_put(&b, "\n", 1);
+        } else {
+            outbuf_str(&b, "{\"id\":");
+            outbuf_int(&b, p->id);
+            outbuf_str(&b, ",\"user_id\":");
+            outbuf_int(&b, p->user_id);
+            outbuf_str(&b, ",\"content\":");
+            outbuf_json_str(&b, post_caption(&app, p));
+            outbuf_str(&b, ",\"media\":");
+            outbuf_json_str(&b, p->media);
+            outbuf_str(&b, ",\"likes\":");
+            outbuf_int(&b, post_likes(p));
+            outbuf_str(&b, ",\"comments\":[");
+        }
+        bool first = true;
+        ColdBlock *cold = p->cold ? load_cold_block(&app, p->id) : NULL;
+        for (int k = 0; cold && k < cold->comment_count; k++, first = false)
+            export_comment(&b, csv, first, &cold->comments[k]);
+        for (; ci < m && comments[ci]->post_id == p->id; ci++, first = false)
+            export_comment(&b, csv, first, comments[ci]);
+        if (!csv) outbuf_str(&b, "]}\n");
+        exported++;
+    }
+    outbuf_flush(&b);
+    if (out != stdout) fclose(out);
+    else fflush(out);
+    fprintf(stderr, "Export %s: %ld post, %lld byte (%.3fs)\n", format, exported, b.written, now_seconds() - start);
+    free(b.data);
+    free(posts);
+    free(comments);
+    free_all(&app);
+    return 0;
+}
+
+// ======================= Batch Mutation =========================
+// Banyak mutasi (mis. dari tool moderasi) diterapkan sekaligus: item diurutkan berdasarkan post
+// (radix sort, stabil sehingga urutan item pada post yang sama tetap), target di-resolve dengan
+// satu kali merge terhadap index ID post, lalu posts.txt/comments.txt ditulis sekali di akhir.
+//
+// Format baris (sama dengan protokol shard):
+//   LIKE uid pid | UNLIKE uid pid | COMMENT uid pid text... | DELETE uid pid | EDIT uid pid media caption...
+
+enum { BATCH_LIKE, BATCH_UNLIKE, BATCH_COMMENT, BATCH_DELETE, BATCH_EDIT };
+enum { BATCH_OK, BATCH_NOT_FOUND, BATCH_UNAUTHORIZED, BATCH_ALREADY_LIKED, BATCH_NOT_LIKED, BATCH_COLD_UNAVAILABLE, BATCH_BAD_REQUEST };
+
+const char *batch_result_names[] = {
+    "OK", "ERR not found", "ERR unauthorized", "ERR already liked", "ERR not liked", "ERR cold unavailable", "ERR bad request"
+};
+
+typedef struct {
+    int op;
+    int user_id;
+    int post_id;
+    char media[MAX_STRING];
+    char text[MAX_STRING]; // Comment atau caption baru
+    int result;
+} BatchItem;
+
+// [Batch] Parse satu baris batch. Return false jika format tidak dikenal
+bool parse_batch_item(const char *line, BatchItem *it) {
+    char cmd[16] = "";
+    memset(it, 0, sizeof(BatchItem));
+    it->op = -1;
+    it->result = BATCH_BAD_REQUEST;
+    if (sscanf(line, "%15s %d %d", cmd, &it->user_id, &it->post_id) != 3) return false;
+    if (strcmp(cmd, "LIKE") == 0) it->op = BATCH_LIKE;
+    else if (strcmp(cmd, "UNLIKE") == 0) it->op = BATCH_UNLIKE;
+    else if (strcmp(cmd, "DELETE") == 0) it->op = BATCH_DELETE;
+    else if (strcmp(cmd, "COMMENT") == 0 && sscanf(line, "%*s %*d %*d %99[^\n]", it->text) == 1) it->op = BATCH_COMMENT;
+    else if (strcmp(cmd, "EDIT") == 0 && sscanf(line, "%*s %*d %*d %99s %99[^\n]", it->media, it->text) == 2) it->op = BATCH_EDIT;
+    else return false;
+    return true;
+}
+
+// [Batch] Terapkan satu item pada post yang sudah di-resolve (NULL = tidak ada).
+// Menandai file mana yang perlu ditulis ulang lewat dirty_posts/dirty_comments
+int apply_batch_item(AppState *app, Post *p, BatchItem *it, bool *dirty_posts, bool *dirty_comments) {
+    if (!p || p->deleted) return BATCH_NOT_FOUND;
+    switch (it->op) {
+        case BATCH_LIKE:
+            if (!post_add_like(p, it->user_id)) return BATCH_ALREADY_LIKED;
+            *dirty_posts = true;
+            return BATCH_OK;
+        case BATCH_UNLIKE:
+            if (!post_remove_like(p, it->user_id)) return BATCH_NOT_LIKED;
+            *dirty_posts = true;
+            return BATCH_OK;
+        case BATCH_COMMENT: {
+            Comment c = {0};
+            c.id = ++app->last_comment_id;
+            c.post_id = p->id;
+            c.user_id = it->user_id;
+            strcpy(c.text, it->text);
+            insert_comment(app, c);
+            index_text_tags(app, p->id, c.text, true);
+            render_cache_touch(p);
+            *dirty_comments = true;
+            return BATCH_OK;
+        }
+        case BATCH_DELETE:
+            if (p->user_id != it->user_id) return BATCH_UNAUTHORIZED;
+            p->deleted = true;
+            p->deleted_seq = app->action_seq;
+            app->tombstones++;
+            app->post_count--;
+            render_cache_drop(app, p->id);
+            *dirty_posts = true;
+            return BATCH_OK;
+        case BATCH_EDIT: {
+            if (p->user_id != it->user_id) return BATCH_UNAUTHORIZED;
+            if (p->cold) {
+                if (!warm_post(app, p)) return BATCH_COLD_UNAVAILABLE;
+                *dirty_comments = true;
+            }
+            char old_caption[MAX_STRING];
+            strcpy(old_caption, p->content);
+            strcpy(p->media, it->media);
+            set_post_caption(p, it->text);
+            retag_post(app, p, old_caption);
+            render_cache_touch(p);
+            *dirty_posts = true;
+            return BATCH_OK;
+        }
+    }
+    return BATCH_BAD_REQUEST;
+}
+
+// [Batch] Terapkan n item sekaligus; hasil per item ditulis ke items[i].result. Return jumlah OK
+int apply_batch(AppState *app, BatchItem *items, int n) {
+    unsigned *keys = (unsigned*)malloc(sizeof(unsigned) * (n + 1));
+    int *order = (int*)malloc(sizeof(int) * (n + 1));
+    int valid = 0;
+    for (int i = 0; i < n; i++) {
+        if (items[i].op < 0) continue; // Baris tidak valid
+        keys[valid] = int_key(items[i].post_id);
+        order[valid++] = i;
+    }
+    radix_sort_pairs(keys, order, valid);
+
+    // Resolve target: merge item terurut dengan index ID post (juga terurut)
+    if (!app->post_index_valid) rebuild_post_index(app);
+    bool dirty_posts = false, dirty_comments = false;
+    int ok = 0, j = 0;
+    for (int k = 0; k < valid; k++) {
+        BatchItem *it = &items[order[k]];
+        while (j < app->post_index_count && app->postIndexIds[j] < it->post_id) j++;
+        Post *p = j < app->post_index_count && app->postIndexIds[j] == it->post_id ? app->postIndex[j] : NULL;
+        it->result = apply_batch_item(app, p, it, &dirty_posts, &dirty_comments);
+        ok += it->result == BATCH_OK;
+    }
+    if (app->tombstones > 0) { // Reklamasi post yang dihapus beserta comment-nya sebelum disimpan
+        int comments_before = app->comment_count;
+        compact_all(app);
+        if (app->comment_count != comments_before) dirty_comments = false; // Sudah ditulis compactor
+    }
+    if (dirty_posts) save_posts(app);
+    if (dirty_comments) save_comments(app);
+    free(keys);
+    free(order);
+    return ok;
+}
+
+// [Batch] Jalur lama sebagai pembanding: cari target dan tulis file untuk setiap item
+int apply_batch_individually(AppState *app, BatchItem *items, int n) {
+    int ok = 0;
+    for (int i = 0; i < n; i++) {
+        if (items[i].op < 0) continue;
+        bool dirty_posts = false, dirty_comments = false;
+        items[i].result = apply_batch_item(app, find_post(app, items[i].post_id), &items[i], &dirty_posts, &dirty_comments);
+        ok += items[i].result == BATCH_OK;
+        if (app->tombstones > 0) compact_all(app);
+        if (dirty_posts) save_posts(app);
+        if (dirty_comments) save_comments(app);
+    }
+    return ok;
+}
+
+// [Batch] Baca file batch (baris kosong & '#' diabaikan). Caller free
+BatchItem* load_batch_file(const char *path, int *n) {
+    FILE *file = fopen(path, "r");
+    if (!file) return NULL;
+    int capacity = 256;
+    BatchItem *items = (BatchItem*)malloc(sizeof(BatchItem) * capacity);
+    char line[MAX_STRING * 4];
+    *n = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (!line[0] || line[0] == '#') continue;
+        if (*n == capacity) {
+            capacity *= 2;
+            items = (BatchItem*)realloc(items, sizeof(BatchItem) * capacity);
+        }
+        parse_batch_item(line, &items[*n]);
+        (*n)++;
+    }
+    fclose(file);
+    return items;
+}
+
+// [Batch] Jalankan file batch terhadap store, cetak hasil per item (nomor baris item) + ringkasan
+int run_batch(const char *path) {
+    int n;
+    BatchItem *items = load_batch_file(path, &n);
+    if (!items) {
+        printf("Gagal membuka %s\n", path);
+        return 1;
+    }
+    AppState app = {0};
+    load_users(&app);
+    load_posts(&app);
+    load_comments(&app);
+    load_cold_index(&app);
+    bulk_build_indexes(&app);
+    int ok = apply_batch(&app, items, n);
+    int counts[BATCH_BAD_REQUEST + 1] = {0};
+    for (int i = 0; i < n; i++) {
+        printf("%d %s\n", i + 1, batch_result_names[items[i].result]);
+        counts[items[i].result]++;
+    }
+    printf("# %d item, %d OK", n, ok);
+    for (int r = BATCH_NOT_FOUND; r <= BATCH_BAD_REQUEST; r++)
+        if (counts[r]) printf(", %d %s", counts[r], batch_result_names[r] + 4);
+    printf("\n");
+    char logmsg[MAX_STRING * 2];
+    snprintf(logmsg, sizeof(logmsg), "Batch %s: %d item, %d OK.", path, n, ok);
+    log_activity(logmsg);
+    free(items);
+    free_all(&app);
+    return 0;
+}
+
+// ======================= Change Stream (Replikasi) =========================
+// Setiap mutasi di server shard diubah dulu menjadi op kanonik (ID post & comment sudah
+// ditentukan) lalu diterapkan lewat apply_change, sehingga primary dan replica menjalankan kode
+// yang sama. Op diberi nomor urut + timestamp dan disimpan di ring untuk replica yang sempat
+// terputus; replica baru (atau yang tertinggal lebih jauh dari ring) di-bootstrap dari snapshot.
+//
+// Record: "R seq timestamp op", op salah satu dari:
+//   USER id username email password | POST pid uid media caption... | LIKE uid pid | UNLIKE uid pid
+//   COMMENT cid uid pid text...     | DELETE pid | EDIT pid media caption...
+// Snapshot: "SNAPSHOT epoch seq", baris M/U/P/L/C, lalu "END".
+
+#define REPL_RING 4096 // Record terakhir yang disimpan untuk catch-up replica
+#define REPL_RECORD (MAX_STRING * 4)
+
+typedef struct {
+    char *records[REPL_RING]; // records[seq % REPL_RING]
+    long head_seq; // Nomor record terakhir
+    int count;
+    long epoch; // Identitas riwayat primary (berganti setiap primary start)
+} ChangeRing;
+
+// [Repl] Post yang masih hidup (bukan tombstone)
+Post* live_post(AppState *app, int post_id) {
+    Post *p = find_post(app, post_id);
+    return p && !p->deleted ? p : NULL;
+}
+
+// [Repl] Terapkan satu op kanonik ke store. Return false jika op tidak berlaku (mis. sudah like)
+bool apply_change(AppState *app, const char *op) {
+    char cmd[16] = "", a[MAX_STRING], b[MAX_STRING], c[MAX_STRING];
+    int x, y, z;
+    Post *p;
+    sscanf(op, "%15s", cmd);
+    if (strcmp(cmd, "USER") == 0 && sscanf(op, "USER %d %99s %99s %99s", &x, a, b, c) == 4) {
+        User u = {0};
+        u.id = x;
+        strcpy(u.username, a);
+        strcpy(u.email, b);
+        strcpy(u.password, c);
+        insert_user(app, u);
+        app->userBST = insert_user_bst(app->userBST, app->users);
+        return true;
+    }
+    if (strcmp(cmd, "POST") == 0 && sscanf(op, "POST %d %d %99s %99[^\n]", &x, &y, a, b) == 4) {
+        Post np = {0};
+        np.id = x;
+        np.user_id = y;
+        strcpy(np.media, a);
+        set_post_caption(&np, b);
+        insert_post(app, np);
+        index_text_tags(app, x, b, true);
+        if (x > app->last_post_id) app->last_post_id = x;
+        return true;
+    }
+    if ((strcmp(cmd, "LIKE") == 0 || strcmp(cmd, "UNLIKE") == 0) && sscanf(op, "%*s %d %d", &x, &y) == 2) {
+        if (!(p = live_post(app, y))) return false;
+        return cmd[0] == 'L' ? post_add_like(p, x) : post_remove_like(p, x);
+    }
+    if (strcmp(cmd, "COMMENT") == 0 && sscanf(op, "COMMENT %d %d %d %99[^\n]", &x, &y, &z, a) == 4) {
+        if (!(p = live_post(app, z))) return false;
+        Comment cm = {0};
+        cm.id = x;
+        cm.user_id = y;
+        cm.post_id = z;
+        strcpy(cm.text, a);
+        insert_comment(app, cm);
+        index_text_tags(app, z, cm.text, true);
+        if (x > app->last_comment_id) app->last_comment_id = x;
+        render_cache_touch(p);
+        return true;
+    }
+    if (strcmp(cmd, "DELETE") == 0 && sscanf(op, "DELETE %d", &x) == 1) {
+        if (!(p = live_post(app, x))) return false;
+        p->deleted = true;
+        p->deleted_seq = app->action_seq;
+        app->tombstones++;
+        app->post_count--;
+        render_cache_drop(app, x);
+        return true;
+    }
+    if (strcmp(cmd, "EDIT") == 0 && sscanf(op, "EDIT %d %99s %99[^\n]", &x, a, b) == 3) {
+        if (!(p = live_post(app, x)) || !warm_post(app, p)) return false;
+        strcpy(c, p->content);
+        strcpy(p->media, a);
+        set_post_caption(p, b);
+        retag_post(app, p, c);
+        render_cache_touch(p);
+        return true;
+    }
+    return false;
+}
+
+// [Repl] Beri nomor urut pada op, simpan record-nya di ring (menimpa yang tertua)
+const char* ring_push(ChangeRing *ring, const char *op) {
+    char record[REPL_RECORD + 64];
+    long seq = ++ring->head_seq;
+    int n = snprintf(record, sizeof(record), "R %ld %.6f %s\n", seq, now_seconds(), op);
+    char **slot = &ring->records[seq % REPL_RING];
+    mem_free(MEM_REPL_LOG, *slot);
+    *slot = (char*)mem_alloc(MEM_REPL_LOG, n + 1);
+    memcpy(*slot, record, n + 1);
+    if (ring->count < REPL_RING) ring->count++;
+    return *slot;
+}
+
+void free_change_ring(ChangeRing *ring) {
+    for (int i = 0; i < REPL_RING; i++) {
+        mem_free(MEM_REPL_LOG, ring->records[i]);
+        ring->records[i] = NULL;
+    }
+    ring->count = 0;
+}
+
+// [Repl] Kumpulkan count node list ke array dengan urutan terbalik (node tertua dulu)
+void** list_oldest_first(void *head, size_t next_offset, int count) {
+    void **arr = (void**)malloc(sizeof(void*) * (count + 1));
+    for (char *node = (char*)head; node; node = *(char**)(node + next_offset))
+        arr[--count] = node;
+    return arr;
+}
+
+// [Repl] Tulis snapshot store pada seq terakhir. Node ditulis dari yang tertua agar replica
+// yang meng-insert di head mendapatkan urutan list yang sama
+void write_snapshot(AppState *app, ChangeRing *ring, char **buf, int *len, int *cap) {
+    char line[MAX_STRING * 5];
+    snprintf(line, sizeof(line), "SNAPSHOT %ld %ld\nM %d %d\n", ring->epoch, ring->head_seq, app->last_post_id, app->last_comment_id);
+    append_buf(buf, len, cap, line);
+
+    int users = 0, posts = 0, comments = 0;
+    for (User *u = app->users; u; u = u->next) users++;
+    for (Post *p = app->posts; p; p = p->next) posts++;
+    for (Comment *c = app->comments; c; c = c->next) comments++;
+    void **arr = list_oldest_first(app->users, offsetof(User, next), users);
+    for (int i = 0; i < users; i++) {
+        User *u = (User*)arr[i];
+        snprintf(line, sizeof(line), "U %d|%s|%s|%s\n", u->id, u->username, u->email, u->password);
+        append_buf(buf, len, cap, line);
+    }
+    free(arr);
+    arr = list_oldest_first(app->posts, offsetof(Post, next), posts);
+    for (int i = 0; i < posts; i++) {
+        Post *p = (Post*)arr[i];
+        if (p->deleted) continue;
+        snprintf(line, sizeof(line), "P %d|%d|%d|%s|%s\n", p->id, p->user_id, p->likes, p->media, post_caption(app, p));
+        append_buf(buf, len, cap, line);
+        int *likers;
+        int liker_count = post_liker_ids(p, &likers);
+        for (int k = 0; k < liker_count; k++) {
+            snprintf(line, sizeof(line), "L %d %d\n", p->id, likers[k]);
+            append_buf(buf, len, cap, line);
+        }
+        free(likers);
+        if (p->cold) { // Comment lama ikut dikirim; di replica semuanya hot
+            ColdBlock *b = load_cold_block(app, p->id);
+            for (int k = 0; b && k < b->comment_count; k++) {
+                snprintf(line, sizeof(line), "C %d|%d|%d|%s\n", b->comments[k].id, p->id, b->comments[k].user_id, b->comments[k].text);
+                append_buf(buf, len, cap, line);
+            }
+        }
+    }
+    free(arr);
+    arr = list_oldest_first(app->comments, offsetof(Comment, next), comments);
+    for (int i = 0; i < comments; i++) {
+        Comment *c = (Comment*)arr[i];
+        if (!live_post(app, c->post_id)) continue; // Post tombstone / sudah direklamasi
+        snprintf(line, sizeof(line), "C %d|%d|%d|%s\n", c->id, c->post_id, c->user_id, c->text);
+        append_buf(buf, len, cap, line);
+    }
+    free(arr);
+    append_buf(buf, len, cap, "END\n");
+}
+
+// [Repl] Terapkan satu baris snapshot ke store replica
+void apply_snapshot_line(AppState *app, const char *line) {
+    if (line[0] == 'M') {
+        sscanf(line, "M %d %d", &app->last_post_id, &app->last_comment_id);
+    } else if (line[0] == 'U') {
+        User u = {0};
+        if (sscanf(line, "U %d|%99[^|]|%99[^|]|%99[^\n]", &u.id, u.username, u.email, u.password) == 4)
+            insert_user(app, u);
+    } else if (line[0] == 'P') {
+        Post p = {0};
+        char caption[MAX_STRING] = "";
+        if (sscanf(line, "P %d|%d|%d|%99[^|]|%99[^\n]", &p.id, &p.user_id, &p.likes, p.media, caption) >= 4) {
+            set_post_caption(&p, caption);
+            insert_post(app, p);
+        }
+    } else if (line[0] == 'L') {
+        int post_id, user_id;
+        if (sscanf(line, "L %d %d", &post_id, &user_id) == 2 && app->posts && app->posts->id == post_id)
+            post_add_like(app->posts, user_id); // Baris L selalu tepat setelah baris P post-nya
+    } else if (line[0] == 'C') {
+        Comment c = {0};
+        if (sscanf(line, "C %d|%d|%d|%99[^\n]", &c.id, &c.post_id, &c.user_id, c.text) == 4)
+            insert_comment(app, c);
+    }
+}
+
+// ======================= Shard (Router & Server) =========================
+// Data dipartisi berdasarkan user_id ke N proses shard, masing-masing dengan direktori
+// (users/posts/comments.txt) sendiri dan Unix socket shard.sock. Post milik user u ada di shard
+// u % N, dan ID post dialokasikan agar post_id % N = shard, jadi operasi per post bisa di-route
+// tanpa scatter. Query lintas shard (TOP, FEED) di-scatter lalu di-merge oleh router.
+//
+// Protokol teks, satu request per baris; respon diakhiri baris ".":
+//   USER uid username email password | POST uid media caption... | LIKE uid pid | UNLIKE uid pid
+//   COMMENT uid pid text...          | DELETE uid pid | EDIT uid pid media caption...
+//   GET pid | TOP k | FEED | STATUS | SHUTDOWN
+//   SUBSCRIBE epoch seq: koneksi menjadi replica dan menerima change stream (tanpa respon ".")
+// Baris data post: "id|user_id|caption|media|likes".
+#ifndef _WIN32
+
+#define SHARD_MAX 64
+#define SHARD_SOCKET "shard.sock"
+
+typedef struct {
+    int fd;
+    char *buf;
+    size_t len, cap;
+    bool subscriber; // Replica yang berlangganan change stream
+    bool closing; // Ditutup setelah putaran poll ini
+    // Buffer keluar subscriber (socket non-blocking): replica yang lambat tidak menahan primary
+    char *out;
+    size_t out_pos, out_len, out_cap;
+    long out_seq; // Seq record tertua yang belum terkirim penuh
+} ShardConn;
+
+// [Shard] Tulis seluruh buffer ke socket
+bool write_all(int fd, const char *data, size_t n) {
+    while (n > 0) {
+        ssize_t w = write(fd, data, n);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        data += w;
+        n -= w;
+    }
+    return true;
+}
+
+// [Shard] Format satu post sebagai baris data protokol
+int format_post_line(AppState *app, Post *p, char *line, size_t size) {
+    return snprintf(line, size, "%d|%d|%s|%s|%d\n", p->id, p->user_id, post_caption(app, p), p->media, post_likes(p));
+}
+
+// [Shard] Kumpulkan post hidup ke array (caller free)
+Post** collect_live_posts(AppState *app, int *n) {
+    Post **arr = (Post**)malloc(sizeof(Post*) * (app->post_count + 1));
+    *n = 0;
+    for (Post *p = app->posts; p; p = p->next)
+        if (!p->deleted) arr[(*n)++] = p;
+    return arr;
+}
+
+// [Shard] Proses satu baris request, tulis respon ke out (buffer yang bisa tumbuh).
+// Mutasi yang berhasil menulis op kanonik ke change (kosong jika tidak ada perubahan)
+// Return false jika request SHUTDOWN
+bool shard_handle(AppState *app, char *req, char *change, char **out, int *len, int *cap) {
+    char cmd[16] = "", a[MAX_STRING], b[MAX_STRING], c[MAX_STRING], line[MAX_STRING * 4];
+    int uid, pid, k;
+    bool running = true;
+    Post *p;
+    change[0] = '\0';
+    sscanf(req, "%15s", cmd);
+    if (strcmp(cmd, "POST") == 0 && sscanf(req, "POST %d %99s %99[^\n]", &uid, a, b) == 3) {
+        pid = next_post_id(app);
+        snprintf(change, REPL_RECORD, "POST %d %d %s %s", pid, uid, a, b);
+        apply_change(app, change);
+        save_posts(app);
+        snprintf(line, sizeof(line), "OK %d\n", pid);
+        append_buf(out, len, cap, line);
+    } else if (strcmp(cmd, "USER") == 0 && sscanf(req, "USER %d %99s %99s %99s", &uid, a, b, c) == 4) {
+        snprintf(change, REPL_RECORD, "USER %d %s %s %s", uid, a, b, c);
+        apply_change(app, change);
+        save_users(app);
+        append_buf(out, len, cap, "OK\n");
+    } else if ((strcmp(cmd, "LIKE") == 0 || strcmp(cmd, "UNLIKE") == 0) && sscanf(req, "%*s %d %d", &uid, &pid) == 2) {
+        if (!live_post(app, pid)) {
+            append_buf(out, len, cap, "ERR not found\n");
+        } else {
+            snprintf(change, REPL_RECORD, "%s %d %d", cmd, uid, pid);
+            if (apply_change(app, change)) {
+                save_posts(app);
+                append_buf(out, len, cap, "OK\n");
+            } else {
+                change[0] = '\0';
+                append_buf(out, len, cap, cmd[0] == 'L' ? "ERR already liked\n" : "ERR not liked\n");
+            }
+        }
+    } else if (strcmp(cmd, "COMMENT") == 0 && sscanf(req, "COMMENT %d %d %99[^\n]", &uid, &pid, a) == 3) {
+        if (!live_post(app, pid)) append_buf(out, len, cap, "ERR not found\n");
+        else {
+            snprintf(change, REPL_RECORD, "COMMENT %d %d %d %s", ++app->last_comment_id, uid, pid, a);
+            apply_change(app, change);
+            save_comments(app);
+            append_buf(out, len, cap, "OK\n");
+        }
+    } else if ((strcmp(cmd, "DELETE") == 0 && sscanf(req, "DELETE %d %d", &uid, &pid) == 2) ||
+               (strcmp(cmd, "EDIT") == 0 && sscanf(req, "EDIT %d %d %99s %99[^\n]", &uid, &pid, a, b) == 4)) {
+        if (!(p = live_post(app, pid))) append_buf(out, len, cap, "ERR not found\n");
+        else if (p->user_id != uid) append_buf(out, len, cap, "ERR unauthorized\n");
+        else {
+            bool was_cold = p->cold;
+            if (cmd[0] == 'D') snprintf(change, REPL_RECORD, "DELETE %d", pid);
+            else snprintf(change, REPL_RECORD, "EDIT %d %s %s", pid, a, b);
+            apply_change(app, change);
+            save_posts(app);
+            if (was_cold && cmd[0] == 'E') save_comments(app); // Comment cold kini ada di comments.txt
+            append_buf(out, len, cap, "OK\n");
+        }
+    } else if (strcmp(cmd, "GET") == 0 && sscanf(req, "GET %d", &pid) == 1) {
+        if (!(p = live_post(app, pid))) append_buf(out, len, cap, "ERR not found\n");
+        else {
+            format_post_line(app, p, line, sizeof(line));
+            append_buf(out, len, cap, line);
+        }
+    } else if ((strcmp(cmd, "TOP") == 0 && sscanf(req, "TOP %d", &k) == 1) || strcmp(cmd, "FEED") == 0) {
+        int n;
+        Post **arr = collect_live_posts(app, &n);
+        if (cmd[0] == 'T') {
+            radix_rank_posts_by_likes(arr, n);
+            if (k < n) n = k < 0 ? 0 : k;
+        } else {
+            radix_sort_posts_by_id(arr, n);
+        }
+        for (int i = 0; i < n; i++) {
+            format_post_line(app, arr[i], line, sizeof(line));
+            append_buf(out, len, cap, line);
+        }
+        free(arr);
+    } else if (strcmp(cmd, "SHUTDOWN") == 0) {
+        append_buf(out, len, cap, "OK\n");
+        running = false;
+    } else {
+        append_buf(out, len, cap, "ERR bad request\n");
+    }
+    append_buf(out, len, cap, ".\n");
+    return running;
+}
+
+// [Shard] Buat socket listen Unix pada path
+int shard_listen(const char *path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    struct sockaddr_un addr = {0};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    unlink(path);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, 64) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// [Shard] Baca data yang tersedia ke buffer koneksi. Return false jika koneksi ditutup
+bool conn_read(ShardConn *conn) {
+    if (conn->len + 4096 > conn->cap) {
+        conn->cap = conn->cap ? conn->cap * 2 : 8192;
+        conn->buf = (char*)realloc(conn->buf, conn->cap);
+    }
+    ssize_t r = read(conn->fd, conn->buf + conn->len, conn->cap - conn->len - 1);
+    if (r < 0 && errno == EINTR) return true;
+    if (r <= 0) return false;
+    conn->len += r;
+    conn->buf[conn->len] = '\0';
+    return true;
+}
+
+// [Shard] Tutup koneksi ke-i dan isi slotnya dengan koneksi terakhir
+void drop_conn(struct pollfd *fds, ShardConn *conns, int *nfds, int i) {
+    close(conns[i].fd);
+    free(conns[i].buf);
+    free(conns[i].out);
+    fds[i] = fds[*nfds - 1];
+    conns[i] = conns[*nfds - 1];
+    (*nfds)--;
+}
+
+// [Repl] Kirim isi buffer keluar subscriber sebanyak yang diterima socket.
+// Return false jika koneksi error
+bool conn_flush(ShardConn *conn) {
+    while (conn->out_pos < conn->out_len) {
+        ssize_t w = write(conn->fd, conn->out + conn->out_pos, conn->out_len - conn->out_pos);
+        if (w < 0 && errno == EINTR) continue;
+        if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (w <= 0) return false;
+        conn->out_pos += w;
+    }
+    if (conn->out_pos == conn->out_len) {
+        conn->out_pos = conn->out_len = 0;
+        return true;
+    }
+    // Record tertua yang belum terkirim penuh menentukan apakah replica masih terkejar ring
+    const char *next = conn->out + conn->out_pos;
+    if (conn->out_pos && next[-1] != '\n' && (next = strchr(next, '\n'))) next++;
+    long seq;
+    if (next && sscanf(next, "R %ld", &seq) == 1) conn->out_seq = seq;
+    if (conn->out_pos > conn->out_cap / 2) { // Geser sisa ke depan agar buffer tidak terus tumbuh
+        conn->out_len -= conn->out_pos;
+        memmove(conn->out, conn->out + conn->out_pos, conn->out_len + 1);
+        conn->out_pos = 0;
+    }
+    return true;
+}
+
+// [Repl] Antrikan data ke buffer keluar subscriber lalu kirim tanpa blocking
+bool conn_send(ShardConn *conn, const char *data, size_t n) {
+    if (conn->out_len + n + 1 > conn->out_cap) {
+        while (conn->out_len + n + 1 > conn->out_cap) conn->out_cap = conn->out_cap ? conn->out_cap * 2 : 8192;
+        conn->out = (char*)realloc(conn->out, conn->out_cap);
+    }
+    memcpy(conn->out + conn->out_len, data, n);
+    conn->out_len += n;
+    conn->out[conn->out_len] = '\0';
+    return conn_flush(conn);
+}
+
+// [Repl] Teruskan satu record ke subscriber. Subscriber yang antreannya masih memuat record
+// yang sudah keluar dari ring diputus; replica akan tersambung ulang dan meminta snapshot
+void repl_publish(ChangeRing *ring, ShardConn *conn, const char *record) {
+    if (conn->out_pos == conn->out_len) conn->out_seq = ring->head_seq; // Antrean kosong
+    else if (conn->out_seq < ring->head_seq - ring->count + 1) {
+        conn->closing = true;
+        return;
+    }
+    if (!conn_send(conn, record, strlen(record))) conn->closing = true;
+}
+
+// [Repl] Layani SUBSCRIBE: kirim record yang tertinggal dari ring, atau snapshot jika
+// riwayatnya berbeda (primary restart) / sudah tidak ada di ring
+void repl_subscribe(AppState *app, ChangeRing *ring, ShardConn *conn, long epoch, long from) {
+    char *buf = NULL;
+    int len = 0, cap = 0;
+    long first = ring->head_seq - ring->count + 1;
+    conn->subscriber = true;
+    fcntl(conn->fd, F_SETFL, fcntl(conn->fd, F_GETFL) | O_NONBLOCK);
+    if (epoch == ring->epoch && from >= first - 1 && from <= ring->head_seq) {
+        for (long seq = from + 1; seq <= ring->head_seq; seq++)
+            append_buf(&buf, &len, &cap, ring->records[seq % REPL_RING]);
+    } else {
+        write_snapshot(app, ring, &buf, &len, &cap);
     }
-    free_post_heap(&heap);
+    conn->out_seq = ring->head_seq + 1; // Antrean snapshot belum memuat record ring
+    if (len && !conn_send(conn, buf, len)) conn->closing = true;
+    free(buf);
 }
 
-// [Stack] Undo delete post
-void undo_delete_post(AppState *app) {
-    if (isUndoEmpty(app)) {
-        printf("No post to undo.\n");
-        return;
+// [Shard] Proses server shard: muat store di dir, layani request dari banyak koneksi (poll).
+// Server ini juga primary untuk replica: setiap mutasi dikirim ke koneksi SUBSCRIBE
+int shard_server(int index, int count, const char *dir) {
+    mkdir(dir, 0755);
+    if (chdir(dir) != 0) {
+        fprintf(stderr, "Shard %d: tidak bisa masuk ke %s\n", index, dir);
+        return 1;
     }
-    Post p = popUndo(app);
-    if (p.id == 0) {
-        printf("No valid post to restore.\n");
-        return;
+    signal(SIGPIPE, SIG_IGN);
+    AppState app = {0};
+    app.shard_index = index;
+    app.shard_count = count;
+    load_users(&app);
+    load_posts(&app);
+    load_comments(&app);
+    load_cold_index(&app);
+    bulk_build_indexes(&app);
+
+    int listen_fd = shard_listen(SHARD_SOCKET);
+    if (listen_fd < 0) {
+        fprintf(stderr, "Shard %d: gagal listen di %s/%s\n", index, dir, SHARD_SOCKET);
+        free_all(&app);
+        return 1;
     }
-    insert_post(app, p);
-    save_posts(app);
-    printf("Undo successful. Post restored!\n");
-    char notif[MAX_STRING * 2];
-    snprintf(notif, sizeof(notif), "You restored post ID %d", p.id);
-    enqueueNotif(app, notif);
+    static ChangeRing ring;
+    ring.epoch = ((long)time(NULL) << 20) ^ getpid();
+    struct pollfd fds[SHARD_MAX * 8 + 1];
+    ShardConn conns[SHARD_MAX * 8 + 1];
+    int nfds = 1;
+    fds[0].fd = listen_fd;
+    fds[0].events = POLLIN;
+    char *out = NULL, change[REPL_RECORD];
+    int out_cap = 0;
+    bool running = true;
+    while (running) {
+        if (poll(fds, nfds, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if ((fds[0].revents & POLLIN) && nfds < SHARD_MAX * 8 + 1) {
+            int fd = accept(listen_fd, NULL, NULL);
+            if (fd >= 0) {
+                fds[nfds].fd = fd;
+                fds[nfds].events = POLLIN;
+                fds[nfds].revents = 0;
+                conns[nfds] = (ShardConn){ .fd = fd };
+                nfds++;
+            }
+        }
+        for (int i = 1; i < nfds && running; i++) {
+            ShardConn *conn = &conns[i];
+            if ((fds[i].revents & POLLOUT) && !conn_flush(conn)) conn->closing = true;
+            if (conn->closing || !(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            if (!conn_read(conn)) { // Koneksi ditutup
+                conn->closing = true;
+                continue;
+            }
+            int out_len = 0;
+            char *start = conn->buf, *nl;
+            while (running && (nl = strchr(start, '\n'))) {
+                *nl = '\0';
+                long epoch, from;
+                if (sscanf(start, "SUBSCRIBE %ld %ld", &epoch, &from) == 2) {
+                    repl_subscribe(&app, &ring, conn, epoch, from);
+                } else if (strcmp(start, "STATUS") == 0) {
+                    int replicas = 0;
+                    for (int r = 1; r < nfds; r++) replicas += conns[r].subscriber;
+                    snprintf(change, sizeof(change), "OK seq %ld replicas %d\n.\n", ring.head_seq, replicas);
+                    append_buf(&out, &out_len, &out_cap, change);
+                } else {
+                    running = shard_handle(&app, start, change, &out, &out_len, &out_cap);
+                    if (change[0]) { // Publikasikan mutasi ke semua replica
+                        const char *record = ring_push(&ring, change);
+                        for (int r = 1; r < nfds; r++)
+                            if (conns[r].subscriber && !conns[r].closing) repl_publish(&ring, &conns[r], record);
+                    }
+                    app.action_seq++;
+                    compact_step(&app, COMPACT_BUDGET);
+                }
+                start = nl + 1;
+            }
+            conn->len -= start - conn->buf;
+            memmove(conn->buf, start, conn->len);
+            if (out_len && !(conn->subscriber ? conn_send(conn, out, out_len) : write_all(conn->fd, out, out_len)))
+                conn->closing = true;
+        }
+        // Buang koneksi yang ditutup; subscriber dengan antrean tertunda menunggu POLLOUT
+        for (int i = 1; i < nfds; i++) {
+            if (conns[i].closing) {
+                drop_conn(fds, conns, &nfds, i--);
+                continue;
+            }
+            fds[i].events = POLLIN | (conns[i].out_pos < conns[i].out_len ? POLLOUT : 0);
+        }
+    }
+    for (int i = 1; i < nfds; i++) {
+        close(conns[i].fd);
+        free(conns[i].buf);
+        free(conns[i].out);
+    }
+    close(listen_fd);
+    unlink(SHARD_SOCKET);
+    free(out);
+    compact_all(&app);
+    free_change_ring(&ring);
+    free_all(&app);
+    return 0;
 }
 
-// [BST] Search post by ID (menggunakan BST)
-void search_post_by_id(AppState *app) {
-    if (!app->posts) {
-        printf("No posts.\n");
-        return;
+// [Shard] Satu percobaan koneksi ke socket Unix. Return -1 jika gagal
+int shard_try_connect(const char *path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    struct sockaddr_un addr = {0};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0) return fd;
+    close(fd);
+    return -1;
+}
+
+// [Shard] Sambungkan ke socket shard (menunggu sampai server siap)
+int shard_connect(const char *path) {
+    for (int attempt = 0; attempt < 500; attempt++) {
+        int fd = shard_try_connect(path);
+        if (fd >= 0) return fd;
+        usleep(10000);
+    }
+    return -1;
+}
+
+// [Shard] Kirim request lalu tunggu respon lengkap (sampai baris "."). Respon di conn->buf
+bool shard_call(ShardConn *conn, const char *req) {
+    if (!write_all(conn->fd, req, strlen(req))) return false;
+    conn->len = 0;
+    for (;;) {
+        if (conn->len + 4096 > conn->cap) {
+            conn->cap = conn->cap ? conn->cap * 2 : 8192;
+            conn->buf = (char*)realloc(conn->buf, conn->cap);
+        }
+        ssize_t r = read(conn->fd, conn->buf + conn->len, conn->cap - conn->len - 1);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        conn->len += r;
+        conn->buf[conn->len] = '\0';
+        if (conn->len >= 2 && strcmp(conn->buf + conn->len - 2, ".\n") == 0 &&
+            (conn->len == 2 || conn->buf[conn->len - 3] == '\n')) {
+            conn->len -= 2;
+            conn->buf[conn->len] = '\0';
+            return true;
+        }
+    }
+}
+
+typedef struct {
+    int count;
+    pid_t pids[SHARD_MAX];
+    char dirs[SHARD_MAX][MAX_STRING];
+} ShardCluster;
+
+// [Shard] Fork N proses shard di base_dir/shard_<i>
+bool start_shards(ShardCluster *cluster, int count, const char *base_dir) {
+    mkdir(base_dir, 0755);
+    cluster->count = count;
+    fflush(stdout);
+    for (int i = 0; i < count; i++) {
+        snprintf(cluster->dirs[i], MAX_STRING, "%s/shard_%d", base_dir, i);
+        pid_t pid = fork();
+        if (pid < 0) return false;
+        if (pid == 0) exit(shard_server(i, count, cluster->dirs[i]));
+        cluster->pids[i] = pid;
+    }
+    return true;
+}
+
+// [Shard] Buka satu koneksi ke setiap shard
+bool connect_shards(ShardCluster *cluster, ShardConn *conns) {
+    char path[MAX_STRING * 2];
+    for (int i = 0; i < cluster->count; i++) {
+        snprintf(path, sizeof(path), "%s/%s", cluster->dirs[i], SHARD_SOCKET);
+        conns[i] = (ShardConn){ .fd = shard_connect(path) };
+        if (conns[i].fd < 0) return false;
+    }
+    return true;
+}
+
+void close_shard_conns(ShardConn *conns, int count) {
+    for (int i = 0; i < count; i++) {
+        if (conns[i].fd >= 0) close(conns[i].fd);
+        free(conns[i].buf);
     }
+}
+
+// [Shard] Hentikan semua shard dan tunggu prosesnya selesai
+void stop_shards(ShardCluster *cluster, ShardConn *conns) {
+    for (int i = 0; i < cluster->count; i++)
+        shard_call(&conns[i], "SHUTDOWN\n");
+    close_shard_conns(conns, cluster->count);
+    for (int i = 0; i < cluster->count; i++)
+        waitpid(cluster->pids[i], NULL, 0);
+}
+
+typedef struct {
     int id;
-    printf("Masukkan ID post yang dicari: ");
-    scanf("%d", &id);
+    int likes;
+    char *line;
+} RoutedPost;
 
-    PostBSTNode *root = build_post_bst(app->posts);
-    Post *found = search_post_bst(root, id);
-    if (found)
-        printf("Ditemukan: [%d] %s Likes: %d\n", found->id, found->content, found->likes);
-    else
-        printf("Post dengan ID %d tidak ditemukan.\n", id);
-    free_post_bst(root);
+// [Shard] Urutan merge: TOP (likes turun, ID naik) atau FEED (ID naik)
+int cmp_routed_top(const void *a, const void *b) {
+    const RoutedPost *x = (const RoutedPost*)a, *y = (const RoutedPost*)b;
+    if (x->likes != y->likes) return y->likes > x->likes ? 1 : -1;
+    return (x->id > y->id) - (x->id < y->id);
 }
 
-// [BST/Linked List] Search post by username/ID
-void search_post(AppState *app) {
-    int opsi;
-    printf("Cari post berdasarkan:\n1. Username\n2. ID\nPilih: ");
-    scanf("%d", &opsi);
-    getchar(); // flush newline
-    if (opsi == 1) {
-        char uname[MAX_STRING];
-        printf("Masukkan username: ");
-        fgets(uname, sizeof(uname), stdin);
-        uname[strcspn(uname, "\n")] = 0;
-        int uid = -1;
-        User *u = app->users;
-        while (u) {
-            if (strcmp(u->username, uname) == 0) {
-                uid = u->id;
-                break;
+int cmp_routed_id(const void *a, const void *b) {
+    const RoutedPost *x = (const RoutedPost*)a, *y = (const RoutedPost*)b;
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+// [Shard] Scatter request ke semua shard lalu merge baris post (limit < 0 = semua)
+void router_gather(ShardConn *conns, int count, const char *req, bool top, int limit, FILE *out) {
+    RoutedPost *rows = NULL;
+    int n = 0, cap = 0;
+    char *copies[SHARD_MAX] = {0};
+    bool sent[SHARD_MAX];
+    for (int s = 0; s < count; s++) // Kirim dulu ke semua shard agar dikerjakan paralel
+        sent[s] = write_all(conns[s].fd, req, strlen(req));
+    for (int s = 0; s < count; s++) {
+        // Shard yang gagal dilaporkan di awal respon; hasil shard lain tetap digabung
+        if (!sent[s] || !shard_call(&conns[s], "")) {
+            fprintf(out, "ERR shard %d unavailable\n", s);
+            continue;
+        }
+        copies[s] = strdup(conns[s].buf);
+        for (char *line = strtok(copies[s], "\n"); line; line = strtok(NULL, "\n")) {
+            if (strncmp(line, "ERR", 3) == 0) {
+                fprintf(out, "ERR shard %d: %s\n", s, line + (line[3] == ' ' ? 4 : 3));
+                continue;
             }
-            u = u->next;
+            if (n == cap) {
+                cap = cap ? cap * 2 : 64;
+                rows = (RoutedPost*)realloc(rows, sizeof(RoutedPost) * cap);
+            }
+            char *last_bar = strrchr(line, '|');
+            rows[n].id = atoi(line);
+            rows[n].likes = last_bar ? atoi(last_bar + 1) : 0;
+            rows[n].line = line;
+            n++;
         }
-        if (uid == -1) {
-            printf("Username tidak ditemukan.\n");
-            return;
+    }
+    qsort(rows, n, sizeof(RoutedPost), top ? cmp_routed_top : cmp_routed_id);
+    if (limit >= 0 && limit < n) n = limit;
+    for (int i = 0; i < n; i++) fprintf(out, "%s\n", rows[i].line);
+    free(rows);
+    for (int s = 0; s < count; s++) free(copies[s]);
+}
+
+// [Shard] Route satu request ke shard pemilik (atau scatter-gather), tulis respon ke out
+void router_dispatch(ShardConn *conns, int count, const char *req, FILE *out) {
+    char cmd[16] = "", line[MAX_STRING * 4];
+    int a = 0, b = 0;
+    sscanf(req, "%15s %d %d", cmd, &a, &b);
+    snprintf(line, sizeof(line), "%s\n", req);
+    int owner = -1;
+    if (strcmp(cmd, "POST") == 0 || strcmp(cmd, "USER") == 0) owner = a;
+    else if (strcmp(cmd, "LIKE") == 0 || strcmp(cmd, "UNLIKE") == 0 || strcmp(cmd, "COMMENT") == 0 ||
+             strcmp(cmd, "DELETE") == 0 || strcmp(cmd, "EDIT") == 0) owner = b;
+    else if (strcmp(cmd, "GET") == 0) owner = a;
+    if (owner >= 0) {
+        if (shard_call(&conns[owner % count], line)) fputs(conns[owner % count].buf, out);
+        else fputs("ERR shard unavailable\n", out);
+    } else if (strcmp(cmd, "TOP") == 0) {
+        char extra;
+        if (sscanf(req, "%*s %d %c", &a, &extra) == 1 && a >= 0) // Jumlah wajib ada dan berupa angka
+            router_gather(conns, count, line, true, a, out);
+        else
+            fputs("ERR bad request\n", out);
+    } else if (strcmp(cmd, "FEED") == 0) {
+        router_gather(conns, count, line, false, -1, out);
+    } else {
+        fputs("ERR bad request\n", out);
+    }
+    fputs(".\n", out);
+}
+
+// [Shard] Router interaktif: jalankan N shard, baca request dari stdin, cetak respon
+int run_router(int count, const char *base_dir) {
+    ShardCluster cluster;
+    ShardConn conns[SHARD_MAX];
+    if (!start_shards(&cluster, count, base_dir) || !connect_shards(&cluster, conns)) {
+        fprintf(stderr, "Gagal menjalankan shard.\n");
+        return 1;
+    }
+    fprintf(stderr, "Router siap: %d shard di %s. Ketik request (USER/POST/LIKE/UNLIKE/COMMENT/DELETE/EDIT/GET/TOP/FEED), EOF untuk keluar.\n", count, base_dir);
+    char req[MAX_STRING * 4];
+    while (fgets(req, sizeof(req), stdin)) {
+        req[strcspn(req, "\r\n")] = '\0';
+        if (!req[0]) continue;
+        router_dispatch(conns, count, req, stdout);
+        fflush(stdout);
+    }
+    stop_shards(&cluster, conns);
+    return 0;
+}
+
+typedef struct {
+    ShardCluster *cluster;
+    int *post_ids;
+    int post_total;
+    int ops;
+    unsigned seed;
+    long done;
+} ShardBenchArg;
+
+// [Shard] Worker benchmark: koneksi sendiri ke tiap shard, campuran LIKE/GET/COMMENT/TOP
+void* shard_bench_worker(void *param) {
+    ShardBenchArg *arg = (ShardBenchArg*)param;
+    ShardConn conns[SHARD_MAX];
+    if (!connect_shards(arg->cluster, conns)) return NULL;
+    FILE *sink = fopen(NULL_DEVICE, "w");
+    char req[MAX_STRING];
+    for (int i = 0; i < arg->ops; i++) {
+        int r = rand_r(&arg->seed) % 100;
+        int pid = arg->post_ids[rand_r(&arg->seed) % arg->post_total];
+        int uid = rand_r(&arg->seed) % 100000 + 1;
+        if (r < 60) snprintf(req, sizeof(req), "LIKE %d %d", uid, pid);
+        else if (r < 90) snprintf(req, sizeof(req), "GET %d", pid);
+        else if (r < 99) snprintf(req, sizeof(req), "COMMENT %d %d bench", uid, pid);
+        else snprintf(req, sizeof(req), "TOP 10");
+        router_dispatch(conns, arg->cluster->count, req, sink);
+        arg->done++;
+    }
+    fclose(sink);
+    close_shard_conns(conns, arg->cluster->count);
+    return NULL;
+}
+
+// [Shard] Hapus file data shard sisa benchmark sebelumnya
+void clean_shard_dir(const char *dir) {
+    const char *files[] = { "users.txt", "posts.txt", "comments.txt", "cold.idx", "cold.seg", "cold.tags", SHARD_SOCKET };
+    char path[MAX_STRING * 2];
+    for (int i = 0; i < 7; i++) {
+        snprintf(path, sizeof(path), "%s/%s", dir, files[i]);
+        unlink(path);
+    }
+}
+
+// [Shard] Benchmark throughput untuk 1, 2, 4, ... max_shards shard
+int bench_shards(int max_shards, int posts, int clients, int ops) {
+    printf("%8s %10s %12s %12s\n", "shards", "ops", "detik", "ops/detik");
+    for (int count = 1; count <= max_shards; count *= 2) {
+        char base[MAX_STRING];
+        snprintf(base, sizeof(base), "shard_bench_%d", count);
+        mkdir(base, 0755);
+        for (int i = 0; i < count; i++) {
+            char dir[MAX_STRING * 2];
+            snprintf(dir, sizeof(dir), "%s/shard_%d", base, i);
+            clean_shard_dir(dir);
         }
-        Post *p = app->posts;
-        int found = 0;
-        while (p) {
-            if (p->user_id == uid) {
-                printf("[%d] %s (%s) Likes: %d\n", p->id, p->content, p->media, p->likes);
-                found = 1;
+        ShardCluster cluster;
+        ShardConn conns[SHARD_MAX];
+        if (!start_shards(&cluster, count, base) || !connect_shards(&cluster, conns)) {
+            printf("Gagal menjalankan %d shard.\n", count);
+            return 1;
+        }
+        // Seed: post dari banyak user agar tersebar ke semua shard
+        int *post_ids = (int*)malloc(sizeof(int) * posts);
+        char req[MAX_STRING];
+        for (int i = 0; i < posts; i++) {
+            int uid = i % 1000 + 1;
+            snprintf(req, sizeof(req), "POST %d img%d.png caption %d\n", uid, i, i);
+            post_ids[i] = shard_call(&conns[uid % count], req) ? atoi(conns[uid % count].buf + 3) : 0;
+        }
+        pthread_t tids[SHARD_MAX * 4];
+        ShardBenchArg args[SHARD_MAX * 4];
+        double start = now_seconds();
+        for (int t = 0; t < clients; t++) {
+            args[t] = (ShardBenchArg){ &cluster, post_ids, posts, ops, (unsigned)(t * 7919 + count), 0 };
+            pthread_create(&tids[t], NULL, shard_bench_worker, &args[t]);
+        }
+        long done = 0;
+        for (int t = 0; t < clients; t++) {
+            pthread_join(tids[t], NULL);
+            done += args[t].done;
+        }
+        double elapsed = now_seconds() - start;
+        printf("%8d %10ld %12.3f %12.0f\n", count, done, elapsed, done / elapsed);
+        stop_shards(&cluster, conns);
+        free(post_ids);
+    }
+    return 0;
+}
+
+
+// ======================= Replica (Read-only) =========================
+// Proses replica berlangganan change stream primary (server shard), menyimpan salinan store di
+// memori, dan melayani GET/TOP/FEED/STATUS di replica.sock. Saat koneksi ke primary putus,
+// replica menyambung ulang dan melanjutkan dari seq terakhir yang sudah diterapkan.
+
+#define REPLICA_SOCKET "replica.sock"
+
+typedef struct {
+    long epoch, applied_seq;
+    bool in_snapshot;
+    long snapshots;
+    double last_lag, max_lag, lag_sum; // Detik dari record dibuat di primary sampai diterapkan
+    long lag_count;
+} ReplicaState;
+
+// [Repl] Proses satu baris dari primary. Return false jika ada lompatan seq (perlu subscribe ulang)
+bool replica_apply_line(AppState *app, ReplicaState *rs, char *line) {
+    long seq;
+    double ts;
+    int offset = 0;
+    if (strncmp(line, "SNAPSHOT ", 9) == 0) {
+        free_all(app);
+        memset(app, 0, sizeof(AppState));
+        app->in_memory = true;
+        sscanf(line, "SNAPSHOT %ld %ld", &rs->epoch, &rs->applied_seq);
+        rs->in_snapshot = true;
+        rs->snapshots++;
+    } else if (rs->in_snapshot) {
+        if (strcmp(line, "END") == 0) {
+            bulk_build_indexes(app);
+            rs->in_snapshot = false;
+        } else {
+            apply_snapshot_line(app, line);
+        }
+    } else if (sscanf(line, "R %ld %lf %n", &seq, &ts, &offset) == 2 && offset > 0) {
+        if (seq <= rs->applied_seq) return true; // Sudah diterapkan
+        if (seq != rs->applied_seq + 1) return false;
+        apply_change(app, line + offset);
+        rs->applied_seq = seq;
+        rs->last_lag = now_seconds() - ts;
+        if (rs->last_lag > rs->max_lag) rs->max_lag = rs->last_lag;
+        rs->lag_sum += rs->last_lag;
+        rs->lag_count++;
+        app->action_seq++;
+        compact_step(app, COMPACT_BUDGET);
+    }
+    return true;
+}
+
+// [Repl] Layani request pembaca di replica (mutasi ditolak)
+bool replica_handle(AppState *app, ReplicaState *rs, char *req, char **out, int *len, int *cap) {
+    char cmd[16] = "", line[MAX_STRING * 2];
+    sscanf(req, "%15s", cmd);
+    if (strcmp(cmd, "STATUS") == 0) {
+        snprintf(line, sizeof(line), "OK seq %ld lag_ms %.3f avg_ms %.3f max_ms %.3f snapshots %ld\n.\n",
+                 rs->applied_seq, rs->last_lag * 1e3, rs->lag_count ? rs->lag_sum * 1e3 / rs->lag_count : 0.0,
+                 rs->max_lag * 1e3, rs->snapshots);
+        append_buf(out, len, cap, line);
+        return true;
+    }
+    if (strcmp(cmd, "SHUTDOWN") != 0 && rs->in_snapshot) {
+        append_buf(out, len, cap, "ERR bootstrapping\n.\n");
+        return true;
+    }
+    if (strcmp(cmd, "GET") == 0 || strcmp(cmd, "TOP") == 0 || strcmp(cmd, "FEED") == 0 || strcmp(cmd, "SHUTDOWN") == 0) {
+        char change[REPL_RECORD];
+        return shard_handle(app, req, change, out, len, cap);
+    }
+    append_buf(out, len, cap, "ERR read-only replica\n.\n");
+    return true;
+}
+
+// [Repl] Proses replica: bootstrap dari snapshot primary_dir, ikuti change stream, layani query
+int replica_server(const char *primary_dir, const char *dir) {
+    char primary_path[MAX_STRING * 2], listen_path[MAX_STRING * 2];
+    snprintf(primary_path, sizeof(primary_path), "%s/%s", primary_dir, SHARD_SOCKET);
+    snprintf(listen_path, sizeof(listen_path), "%s/%s", dir, REPLICA_SOCKET);
+    mkdir(dir, 0755);
+    signal(SIGPIPE, SIG_IGN);
+    int listen_fd = shard_listen(listen_path);
+    if (listen_fd < 0) {
+        fprintf(stderr, "Replica: gagal listen di %s\n", listen_path);
+        return 1;
+    }
+    AppState app = {0};
+    app.in_memory = true;
+    ReplicaState rs = {0};
+    // fds[0] = listen, fds[1] = primary (fd -1 saat terputus; poll mengabaikan fd negatif)
+    struct pollfd fds[SHARD_MAX * 8 + 2];
+    ShardConn conns[SHARD_MAX * 8 + 2];
+    int nfds = 2;
+    fds[0].fd = listen_fd;
+    fds[0].events = POLLIN;
+    conns[1] = (ShardConn){ .fd = -1, .subscriber = true };
+    char *out = NULL;
+    int out_cap = 0;
+    bool running = true;
+    while (running) {
+        if (conns[1].fd < 0 && (conns[1].fd = shard_try_connect(primary_path)) >= 0) {
+            char req[64];
+            snprintf(req, sizeof(req), "SUBSCRIBE %ld %ld\n", rs.epoch, rs.applied_seq);
+            write_all(conns[1].fd, req, strlen(req));
+            conns[1].len = 0;
+        }
+        fds[1].fd = conns[1].fd;
+        fds[1].events = POLLIN;
+        if (poll(fds, nfds, conns[1].fd < 0 ? 100 : -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if ((fds[0].revents & POLLIN) && nfds < SHARD_MAX * 8 + 2) {
+            int fd = accept(listen_fd, NULL, NULL);
+            if (fd >= 0) {
+                fds[nfds].fd = fd;
+                fds[nfds].events = POLLIN;
+                fds[nfds].revents = 0;
+                conns[nfds] = (ShardConn){ .fd = fd };
+                nfds++;
+            }
+        }
+        for (int i = 1; i < nfds && running; i++) {
+            if (conns[i].fd < 0 || !(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            ShardConn *conn = &conns[i];
+            bool ok = conn_read(conn);
+            int out_len = 0;
+            char *start = conn->buf, *nl;
+            while (ok && running && (nl = strchr(start, '\n'))) {
+                *nl = '\0';
+                if (i == 1) ok = replica_apply_line(&app, &rs, start);
+                else running = replica_handle(&app, &rs, start, &out, &out_len, &out_cap);
+                start = nl + 1;
+            }
+            if (ok) {
+                conn->len -= start - conn->buf;
+                memmove(conn->buf, start, conn->len);
+                if (out_len) write_all(conn->fd, out, out_len);
+            } else if (i == 1) { // Primary putus / stream tidak urut: sambung ulang
+                close(conn->fd);
+                conn->fd = -1;
+                conn->len = 0;
+                if (rs.in_snapshot) rs.epoch = 0; // Snapshot belum lengkap: minta ulang
+            } else {
+                drop_conn(fds, conns, &nfds, i--);
+            }
+        }
+    }
+    for (int i = 1; i < nfds; i++) {
+        if (conns[i].fd >= 0) close(conns[i].fd);
+        free(conns[i].buf);
+    }
+    close(listen_fd);
+    unlink(listen_path);
+    free(out);
+    free_all(&app);
+    return 0;
+}
+
+// [Repl] Fork satu proses replica
+pid_t start_replica(const char *primary_dir, const char *dir) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) exit(replica_server(primary_dir, dir));
+    return pid;
+}
+
+// [Repl] Ambil nilai field angka dari baris STATUS, mis. status_field(buf, "seq")
+double status_field(const char *status, const char *name) {
+    char key[32];
+    snprintf(key, sizeof(key), " %s ", name);
+    const char *at = strstr(status, key);
+    return at ? atof(at + strlen(key)) : -1;
+}
+
+// [Repl] Benchmark: primary + N replica, replica terakhir bootstrap di tengah beban tulis.
+// Laporkan throughput tulis, lag replikasi, waktu catch-up, dan cek FEED replica = primary
+int bench_replication(int replicas, int ops) {
+    const char *base = "repl_bench";
+    char (*dirs)[MAX_STRING] = (char(*)[MAX_STRING])malloc(sizeof(*dirs) * replicas);
+    char path[MAX_STRING * 2];
+    mkdir(base, 0755);
+    snprintf(path, sizeof(path), "%s/shard_0", base);
+    clean_shard_dir(path);
+    ShardCluster primary;
+    ShardConn pconn;
+    if (!start_shards(&primary, 1, base) || !connect_shards(&primary, &pconn)) {
+        printf("Gagal menjalankan primary.\n");
+        return 1;
+    }
+    srand(4242);
+    int seeds = 200, post_total = 0;
+    int *post_ids = (int*)malloc(sizeof(int) * (seeds + ops));
+    int *post_owner = (int*)malloc(sizeof(int) * (seeds + ops));
+    char req[MAX_STRING * 2];
+    for (int i = 0; i < seeds; i++) {
+        int uid = i % 50 + 1;
+        snprintf(req, sizeof(req), "POST %d img%d.png seed caption %d\n", uid, i, i);
+        if (shard_call(&pconn, req)) {
+            post_owner[post_total] = uid;
+            post_ids[post_total++] = atoi(pconn.buf + 3);
+        }
+    }
+    pid_t pids[SHARD_MAX];
+    for (int r = 0; r < replicas; r++) {
+        snprintf(dirs[r], MAX_STRING, "%s/replica_%d", base, r);
+        if (r < replicas - 1 || replicas == 1) pids[r] = start_replica(primary.dirs[0], dirs[r]);
+    }
+    double start = now_seconds();
+    for (int i = 0; i < ops; i++) {
+        if (i == ops / 2 && replicas > 1) // Replica terakhir: bootstrap dari snapshot saat beban berjalan
+            pids[replicas - 1] = start_replica(primary.dirs[0], dirs[replicas - 1]);
+        int r = rand() % 100, k = rand() % post_total, uid = rand() % 5000 + 1;
+        if (r < 60) snprintf(req, sizeof(req), "LIKE %d %d\n", uid, post_ids[k]);
+        else if (r < 70) snprintf(req, sizeof(req), "UNLIKE %d %d\n", uid, post_ids[k]);
+        else if (r < 85) snprintf(req, sizeof(req), "COMMENT %d %d komentar %d\n", uid, post_ids[k], i);
+        else if (r < 93) snprintf(req, sizeof(req), "POST %d new%d.png post baru %d\n", uid % 50 + 1, i, i);
+        else if (r < 99) snprintf(req, sizeof(req), "EDIT %d %d edit%d.png caption edit %d\n", post_owner[k], post_ids[k], i, i);
+        else snprintf(req, sizeof(req), "DELETE %d %d\n", post_owner[k], post_ids[k]);
+        if (shard_call(&pconn, req) && req[0] == 'P' && strncmp(pconn.buf, "OK ", 3) == 0) {
+            post_owner[post_total] = uid % 50 + 1;
+            post_ids[post_total++] = atoi(pconn.buf + 3);
+        }
+    }
+    double elapsed = now_seconds() - start;
+    shard_call(&pconn, "STATUS\n");
+    long head = (long)status_field(pconn.buf, "seq");
+    printf("primary: %d op tulis, %.0f op/detik, seq akhir %ld\n", ops, ops / elapsed, head);
+
+    shard_call(&pconn, "FEED\n");
+    char *feed = strdup(pconn.buf);
+    bool ok = true;
+    printf("%8s %8s %10s %10s %10s %12s %6s\n", "replica", "seq", "avg_ms", "max_ms", "snapshot", "catch-up ms", "FEED");
+    for (int r = 0; r < replicas; r++) {
+        snprintf(path, sizeof(path), "%s/%s", dirs[r], REPLICA_SOCKET);
+        ShardConn rconn = { .fd = shard_connect(path) };
+        double wait_start = now_seconds();
+        while (rconn.fd >= 0 && shard_call(&rconn, "STATUS\n") && status_field(rconn.buf, "seq") < head &&
+               now_seconds() - wait_start < 10)
+            usleep(1000);
+        double catchup = (now_seconds() - wait_start) * 1e3;
+        char status[MAX_STRING * 2];
+        snprintf(status, sizeof(status), "%s", rconn.buf ? rconn.buf : "");
+        bool same = rconn.fd >= 0 && shard_call(&rconn, "FEED\n") && strcmp(rconn.buf, feed) == 0;
+        ok &= same;
+        printf("%8d %8.0f %10.3f %10.3f %10.0f %12.1f %6s\n", r, status_field(status, "seq"), status_field(status, "avg_ms"),
+               status_field(status, "max_ms"), status_field(status, "snapshots"), catchup, same ? "OK" : "GAGAL");
+        if (rconn.fd >= 0) shard_call(&rconn, "SHUTDOWN\n");
+        close_shard_conns(&rconn, 1);
+        waitpid(pids[r], NULL, 0);
+    }
+    stop_shards(&primary, &pconn);
+    free(feed);
+    free(dirs);
+    free(post_ids);
+    free(post_owner);
+    return ok ? 0 : 1;
+}
+
+#endif
+
+// ======================= Tools (CLI) =========================
+
+typedef struct {
+    Post *post;
+    int thread_index;
+    int user_count;
+    int rounds;
+    long liked;
+} LikeBenchArg;
+
+// [Tools] Worker benchmark: semua thread me-like user yang sama (urutan digeser per thread)
+void* like_bench_worker(void *param) {
+    LikeBenchArg *arg = (LikeBenchArg*)param;
+    int offset = arg->thread_index * 7919;
+    for (int r = 0; r < arg->rounds; r++) {
+        for (int i = 0; i < arg->user_count; i++) {
+            int uid = (i + offset) % arg->user_count + 1;
+            arg->liked += post_add_like(arg->post, uid);
+        }
+        if (r + 1 < arg->rounds) {
+            for (int i = 0; i < arg->user_count; i++) {
+                int uid = (i + offset) % arg->user_count + 1;
+                arg->liked -= post_remove_like(arg->post, uid);
+            }
+        }
+    }
+    return NULL;
+}
+
+// [Tools] Stress test like/unlike pada satu post dari banyak thread
+int bench_likes_run(int threads, int user_count, int rounds) {
+    Post post = {0};
+    post.id = 1;
+    pthread_t *tids = (pthread_t*)malloc(sizeof(pthread_t) * threads);
+    LikeBenchArg *args = (LikeBenchArg*)calloc(threads, sizeof(LikeBenchArg));
+    double start = now_seconds();
+    for (int t = 0; t < threads; t++) {
+        args[t].post = &post;
+        args[t].thread_index = t;
+        args[t].user_count = user_count;
+        args[t].rounds = rounds;
+        pthread_create(&tids[t], NULL, like_bench_worker, &args[t]);
+    }
+    long net = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+        net += args[t].liked;
+    }
+    double elapsed = now_seconds() - start;
+
+    // Validasi: tiap user tepat satu kali di set liker, counter sama dengan jumlah liker aktif
+    char *seen = (char*)calloc(user_count + 1, 1);
+    int *likers;
+    int active = post_liker_ids(&post, &likers), duplicates = 0;
+    for (int i = 0; i < active; i++) {
+        if (likers[i] < 1 || likers[i] > user_count || seen[likers[i]]) duplicates++;
+        else seen[likers[i]] = 1;
+    }
+    long ops = (long)threads * user_count * (2L * rounds - 1);
+    int likes = post_likes(&post);
+    bool ok = likes == user_count && active == user_count && net == user_count && duplicates == 0;
+    printf("threads=%d users=%d rounds=%d ops=%ld time=%.3fs (%.0f ops/s)\n",
+           threads, user_count, rounds, ops, elapsed, ops / elapsed);
+    printf("likes=%d active=%d net=%ld duplicates=%d -> %s\n",
+           likes, active, net, duplicates, ok ? "OK" : "FAIL");
+    free(likers);
+    free(seen);
+    free_post_likes(&post);
+    free(args);
+    free(tids);
+    return ok ? 0 : 1;
+}
+
+// [Tools] Tanpa jumlah user: sapu jumlah liker kecil sampai besar, masing-masing 1 thread dan N thread
+int bench_likes(int threads, int user_count, int rounds) {
+    if (user_count > 0) return bench_likes_run(threads, user_count, rounds);
+    const int sizes[] = {2000, 20000, 200000};
+    int failed = 0;
+    for (int i = 0; i < 3; i++) {
+        failed |= bench_likes_run(1, sizes[i], rounds);
+        if (threads > 1) failed |= bench_likes_run(threads, sizes[i], rounds);
+    }
+    return failed;
+}
+
+// [Tools] Benchmark kernel radix/lower bound vs bubble_sort_posts_by_id, quick_sort_posts, binary_search_post
+int bench_sort(int n, int queries) {
+    Post *posts = (Post*)calloc(n, sizeof(Post));
+    Post **base = (Post**)malloc(sizeof(Post*) * n);
+    Post **arr = (Post**)malloc(sizeof(Post*) * n);
+    srand(12345);
+    for (int i = 0; i < n; i++) {
+        posts[i].id = i + 1;
+        posts[i].likes = rand() % 1000;
+        base[i] = &posts[i];
+    }
+    for (int i = n - 1; i > 0; i--) { // Acak urutan
+        int j = rand() % (i + 1);
+        Post *tmp = base[i];
+        base[i] = base[j];
+        base[j] = tmp;
+    }
+    bool ok = true;
+    double t;
+
+    printf("n=%d\n", n);
+    if (n <= 20000) {
+        memcpy(arr, base, sizeof(Post*) * n);
+        t = now_seconds();
+        bubble_sort_posts_by_id(arr, n);
+        printf("  bubble_sort_posts_by_id   : %9.3f ms\n", (now_seconds() - t) * 1e3);
+    } else {
+        printf("  bubble_sort_posts_by_id   : dilewati (n > 20000)\n");
+    }
+    memcpy(arr, base, sizeof(Post*) * n);
+    t = now_seconds();
+    radix_sort_posts_by_id(arr, n);
+    printf("  radix_sort_posts_by_id    : %9.3f ms\n", (now_seconds() - t) * 1e3);
+    for (int i = 0; i < n; i++) ok &= arr[i]->id == i + 1;
+
+    memcpy(arr, base, sizeof(Post*) * n);
+    t = now_seconds();
+    quick_sort_posts(arr, 0, n - 1);
+    printf("  quick_sort_posts (likes)  : %9.3f ms\n", (now_seconds() - t) * 1e3);
+    memcpy(arr, base, sizeof(Post*) * n);
+    t = now_seconds();
+    radix_rank_posts_by_likes(arr, n);
+    printf("  radix_rank_posts_by_likes : %9.3f ms\n", (now_seconds() - t) * 1e3);
+    for (int i = 1; i < n; i++)
+        ok &= arr[i-1]->likes > arr[i]->likes || (arr[i-1]->likes == arr[i]->likes && arr[i-1]->id < arr[i]->id);
+
+    // Lookup: binary_search_post (array pointer) vs lower bound branchless (array key contiguous)
+    radix_sort_posts_by_id(arr, n);
+    int *ids = (int*)malloc(sizeof(int) * n);
+    int *targets = (int*)malloc(sizeof(int) * queries);
+    for (int i = 0; i < n; i++) ids[i] = arr[i]->id;
+    for (int q = 0; q < queries; q++) targets[q] = rand() % (n + n / 10 + 1) + 1;
+    long hits_a = 0, hits_b = 0;
+    t = now_seconds();
+    for (int q = 0; q < queries; q++) hits_a += binary_search_post(arr, n, targets[q]) >= 0;
+    printf("  binary_search_post        : %9.3f ms (%d query)\n", (now_seconds() - t) * 1e3, queries);
+    t = now_seconds();
+    for (int q = 0; q < queries; q++) {
+        int i = lower_bound_int(ids, n, targets[q]);
+        hits_b += i < n && ids[i] == targets[q];
+    }
+    printf("  lower_bound_int           : %9.3f ms (%d query)\n", (now_seconds() - t) * 1e3, queries);
+    ok &= hits_a == hits_b;
+    printf("  hasil: %s\n", ok ? "OK" : "FAIL");
+
+    free(ids);
+    free(targets);
+    free(arr);
+    free(base);
+    free(posts);
+    return ok ? 0 : 1;
+}
+
+// [Render] Baca seluruh isi file sementara (untuk membandingkan output view)
+char* read_whole_file(FILE *file, long *len) {
+    fflush(file);
+    *len = ftell(file);
+    char *data = (char*)malloc(*len + 1);
+    rewind(file);
+    *len = fread(data, 1, *len, file);
+    data[*len] = '\0';
+    return data;
+}
+
+// [Render] Benchmark view_posts berulang: tanpa cache vs dengan cache (sebagian post di-like tiap view)
+int bench_render(int n, int views, size_t cap) {
+    AppState app = {0};
+    srand(777);
+    for (int i = 1; i <= n; i++) {
+        Post p = {0};
+        p.id = i;
+        p.user_id = rand() % 100 + 1;
+        char caption[MAX_STRING];
+        snprintf(caption, sizeof(caption), "caption post %d", i);
+        set_post_caption(&p, caption);
+        snprintf(p.media, MAX_STRING, "img%d.jpg", i);
+        insert_post(&app, p);
+    }
+    for (int i = 1; i <= n * 3; i++) {
+        Comment c = {0};
+        c.id = i;
+        c.post_id = rand() % n + 1;
+        c.user_id = rand() % 100 + 1;
+        snprintf(c.text, MAX_STRING, "comment %d", i);
+        insert_comment(&app, c);
+    }
+    FILE *sink = fopen(NULL_DEVICE, "w");
+    if (!sink) sink = tmpfile(); // Tanpa null device: tulis ke file sementara
+    FILE *plain = tmpfile(), *cached = tmpfile();
+    if (!sink || !plain || !cached) {
+        printf("Gagal membuka file sementara.\n");
+        if (sink) fclose(sink);
+        if (plain) fclose(plain);
+        if (cached) fclose(cached);
+        free_all(&app);
+        return 1;
+    }
+    double elapsed[2];
+    for (int pass = 0; pass < 2; pass++) {
+        app.render_cache_cap = pass ? cap : 0;
+        app.render_hits = app.render_misses = app.render_evictions = 0;
+        double t = now_seconds();
+        for (int v = 0; v < views; v++) {
+            for (int k = 0; k < n / 100 + 1; k++) { // Like acak: blok post tsb jadi basi
+                Post *p = find_post(&app, rand() % n + 1);
+                if (p) post_add_like(p, 1000 + v * 100 + k);
+            }
+            write_posts_view(&app, sink);
+        }
+        elapsed[pass] = now_seconds() - t;
+    }
+    write_posts_view(&app, cached);
+    app.render_cache_cap = 0;
+    write_posts_view(&app, plain);
+    app.render_cache_cap = cap;
+    long len_plain, len_cached;
+    char *a = read_whole_file(plain, &len_plain), *b = read_whole_file(cached, &len_cached);
+    bool ok = len_plain == len_cached && memcmp(a, b, len_plain) == 0;
+    printf("posts=%d comments=%d views=%d cap=%zu KB\n", n, n * 3, views, cap / 1024);
+    printf("  tanpa cache : %9.3f ms/view\n", elapsed[0] * 1e3 / views);
+    printf("  dengan cache: %9.3f ms/view (%.1fx)\n", elapsed[1] * 1e3 / views, elapsed[0] / elapsed[1]);
+    show_render_cache_stats(&app, stdout);
+    printf("  output sama : %s\n", ok ? "OK" : "GAGAL");
+    free(a);
+    free(b);
+    fclose(sink);
+    fclose(plain);
+    fclose(cached);
+    free_all(&app);
+    return ok ? 0 : 1;
+}
+
+// [Trend] Generator acak xorshift (deterministik, periode panjang)
+unsigned long xorshift64(unsigned long *state) {
+    unsigned long x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+// [Trend] Ambil indeks tag berdistribusi Zipf dari CDF kumulatif (total = cdf terakhir)
+int zipf_sample(const double *cdf, int distinct, double total, unsigned long *rng) {
+    double u = (double)(xorshift64(rng) >> 11) / (double)(1UL << 53) * total;
+    int lo = 0, hi = distinct - 1;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (cdf[mid] < u) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+const long *exact_counts_for_sort; // Dipakai cmp_exact_tag (qsort tidak punya argumen konteks)
+
+int cmp_exact_tag(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    const long *counts = exact_counts_for_sort;
+    if (counts[x] != counts[y]) return counts[x] < counts[y] ? 1 : -1;
+    return (x > y) - (x < y);
+}
+
+// [Trend] Uji dengan peluruhan aktif: stream lama (#old*) disusul stream baru (#new*) sepanjang
+// occurrences. Hitungan exact dibagi dua pada jadwal yang sama dengan sketch; top 20 sketch harus
+// cocok dengan top 20 exact, tidak ada estimasi di bawah exact, dan tag lama tidak lebih banyak
+// bertahan di top 20 sketch daripada di top 20 exact
+int check_trending_decay(int occurrences, int distinct) {
+    AppState app = {0};
+    TrendSketch *ts = trend_sketch(&app);
+    double *cdf = (double*)malloc(sizeof(double) * distinct);
+    long *exact = (long*)calloc(2 * distinct, sizeof(long)); // [0, distinct) lama, sisanya baru
+    double total = 0;
+    for (int i = 0; i < distinct; i++) {
+        total += 1.0 / (i + 1);
+        cdf[i] = total;
+    }
+    unsigned long rng = 2463534242UL;
+    char tag[TAG_MAX + 2];
+    long events = 0;
+    for (int phase = 0; phase < 2; phase++) {
+        for (int i = 0; i < occurrences; i++) {
+            int k = zipf_sample(cdf, distinct, total, &rng);
+            snprintf(tag, sizeof(tag), phase ? "#new%d" : "#old%d", k);
+            trend_add(ts, tag);
+            exact[phase * distinct + k]++;
+            if (++events >= ts->half_life) {
+                for (int j = 0; j < 2 * distinct; j++) exact[j] >>= 1;
+                events = 0;
+            }
+        }
+    }
+
+    int *order = (int*)malloc(sizeof(int) * 2 * distinct);
+    for (int i = 0; i < 2 * distinct; i++) order[i] = i;
+    exact_counts_for_sort = exact;
+    qsort(order, 2 * distinct, sizeof(int), cmp_exact_tag);
+    TrendItem top[20];
+    int n = trend_top(ts, top, 20), hits = 0, stale = 0, exact_stale = 0, under = 0;
+    for (int j = 0; j < 20 && j < 2 * distinct; j++) exact_stale += order[j] < distinct && exact[order[j]] > 0;
+    for (int i = 0; i < n; i++) {
+        int id = atoi(top[i].tag + 4) + (top[i].tag[1] == 'n' ? distinct : 0);
+        stale += top[i].tag[1] == 'o';
+        for (int j = 0; j < 20 && j < 2 * distinct; j++) hits += order[j] == id;
+    }
+    for (int i = 0; i < 2 * distinct; i++) {
+        snprintf(tag, sizeof(tag), i < distinct ? "#old%d" : "#new%d", i % distinct);
+        under += trend_estimate(ts, tag) < exact[i];
+    }
+    int expected = distinct < 20 ? distinct : 20;
+    bool ok = hits >= expected - 1 && stale <= exact_stale && under == 0;
+    printf("peluruhan: half_life=%ld, %d kemunculan lama lalu %d baru\n", ts->half_life, occurrences, occurrences);
+    printf("  recall top 20        : %d/%d\n", hits, expected);
+    printf("  tag lama di top 20   : %d (exact %d)\n", stale, exact_stale);
+    printf("  estimasi < exact     : %d tag\n", under);
+    printf("  hasil                : %s\n", ok ? "OK" : "GAGAL");
+    free(cdf);
+    free(exact);
+    free(order);
+    free_all(&app);
+    return ok ? 0 : 1;
+}
+
+// [Trend] Uji akurasi sketch vs hitungan exact pada dataset Zipf (s = 1) hasil generate:
+// recall top 20, galat relatif estimasi top 20, dan batas galat count-min (eps = e / width)
+int check_trending(int occurrences, int distinct) {
+    AppState app = {0};
+    TrendSketch *ts = trend_sketch(&app);
+    ts->half_life = 0; // Hitungan exact tidak meluruh, sketch juga tidak
+    double *cdf = (double*)malloc(sizeof(double) * distinct);
+    long *exact = (long*)calloc(distinct, sizeof(long));
+    double total = 0;
+    for (int i = 0; i < distinct; i++) {
+        total += 1.0 / (i + 1);
+        cdf[i] = total;
+    }
+    unsigned long rng = 88172645463325252UL;
+    char caption[MAX_STRING];
+    int post_id = 0, written = 0;
+    while (written < occurrences) { // Tiap post membawa 1-3 hashtag dan kadang mention
+        int tags = (int)(xorshift64(&rng) % 3) + 1, len = 0;
+        post_id++;
+        len += snprintf(caption + len, sizeof(caption) - len, "post %d", post_id);
+        for (int t = 0; t < tags && written < occurrences; t++, written++) {
+            int lo = zipf_sample(cdf, distinct, total, &rng);
+            exact[lo]++;
+            len += snprintf(caption + len, sizeof(caption) - len, " #Tag%d", lo);
+        }
+        if (post_id % 5 == 0) snprintf(caption + len, sizeof(caption) - len, " @user%d", post_id % 97);
+        index_text_tags(&app, post_id, caption, true);
+    }
+
+    int *order = (int*)malloc(sizeof(int) * distinct);
+    for (int i = 0; i < distinct; i++) order[i] = i;
+    exact_counts_for_sort = exact;
+    qsort(order, distinct, sizeof(int), cmp_exact_tag);
+    TrendItem top[20];
+    int n = trend_top(ts, top, 20), hits = 0;
+    double max_rel = 0;
+    for (int i = 0; i < n; i++) {
+        int id = atoi(top[i].tag + 4); // "#tag<id>"
+        for (int j = 0; j < 20 && j < distinct; j++) hits += order[j] == id;
+        double rel = (double)(top[i].count - exact[id]) / exact[id];
+        if (rel > max_rel) max_rel = rel;
+    }
+    // Batas count-min: est >= exact, dan est - exact <= eps * N untuk (1 - e^-depth) tag
+    double eps_n = 2.718281828 / TREND_WIDTH * occurrences;
+    int under = 0, over_bound = 0;
+    char tag[TAG_MAX + 2];
+    for (int i = 0; i < distinct; i++) {
+        snprintf(tag, sizeof(tag), "#tag%d", i);
+        unsigned est = trend_estimate(ts, tag);
+        under += est < exact[i];
+        over_bound += est - exact[i] > eps_n;
+    }
+    double bound_rate = (double)over_bound / distinct;
+    int expected = distinct < 20 ? distinct : 20;
+    bool ok = hits >= expected - 1 && under == 0 && bound_rate <= 0.02;
+    TagEntry *e = find_tag(&app, "#tag0", false);
+
+    printf("kemunculan=%d tag berbeda=%d post=%d\n", occurrences, distinct, post_id);
+    printf("  memori sketch        : %zu bytes (tetap)\n", sizeof(TrendSketch));
+    printf("  memori hitungan exact: %zu bytes (tumbuh dengan jumlah tag)\n", sizeof(long) * distinct);
+    printf("  recall top 20        : %d/%d\n", hits, expected);
+    printf("  galat relatif top 20 : maks %.2f%%\n", max_rel * 100);
+    printf("  estimasi < exact     : %d tag\n", under);
+    printf("  galat > eps*N        : %.2f%% tag (eps*N = %.0f, batas e^-depth = 1.83%%)\n", bound_rate * 100, eps_n);
+    printf("  index #tag0          : %d post\n", e ? e->count : 0);
+    printf("  hasil                : %s\n", ok ? "OK" : "GAGAL");
+    for (int i = 0; i < n && i < 5; i++)
+        printf("    %d. %-10s sketch=%u exact=%ld\n", i + 1, top[i].tag, top[i].count, exact[atoi(top[i].tag + 4)]);
+    free(cdf);
+    free(exact);
+    free(order);
+    free_all(&app);
+    return check_trending_decay(occurrences, distinct) || !ok;
+}
+
+#ifndef _WIN32
+// [Batch] Tulis store contoh (posts.txt + comments.txt) di direktori kerja
+void seed_batch_store(int posts) {
+    AppState app = {0};
+    for (int i = 1; i <= posts; i++) {
+        Post p = {0};
+        p.id = i;
+        p.user_id = i % 100 + 1;
+        p.likes = i % 7;
+        char caption[MAX_STRING];
+        snprintf(caption, sizeof(caption), "caption %d", i);
+        set_post_caption(&p, caption);
+        snprintf(p.media, MAX_STRING, "img%d.jpg", i);
+        insert_post(&app, p);
+        Comment c = {0};
+        c.id = i;
+        c.post_id = i;
+        c.user_id = (i * 31) % 100 + 1;
+        snprintf(c.text, MAX_STRING, "comment %d", i);
+        insert_comment(&app, c);
+    }
+    save_posts(&app);
+    save_comments(&app);
+    free_all(&app);
+}
+
+// [Batch] Muat store dari direktori kerja
+void load_batch_store(AppState *app) {
+    memset(app, 0, sizeof(AppState));
+    load_posts(app);
+    load_comments(app);
+}
+
+// [Batch] Benchmark apply_batch vs operasi satu per satu (cari + tulis file per item)
+int bench_batch(int posts, int ops) {
+    mkdir("batch_bench", 0755);
+    if (chdir("batch_bench") != 0) return 1;
+    srand(99);
+    BatchItem *items = (BatchItem*)malloc(sizeof(BatchItem) * ops);
+    char line[MAX_STRING * 2];
+    for (int i = 0; i < ops; i++) {
+        int r = rand() % 100, pid = rand() % (posts + posts / 20) + 1, uid = rand() % 2000 + 1;
+        int owner = rand() % 4 ? pid % 100 + 1 : uid; // Sebagian edit/delete oleh bukan pemilik
+        if (r < 70) snprintf(line, sizeof(line), "LIKE %d %d", uid % 50 + 1, pid);
+        else if (r < 80) snprintf(line, sizeof(line), "UNLIKE %d %d", uid % 50 + 1, pid);
+        else if (r < 95) snprintf(line, sizeof(line), "COMMENT %d %d batch comment %d", uid, pid, i);
+        else if (r < 98) snprintf(line, sizeof(line), "EDIT %d %d new%d.png edited %d", owner, pid, i, i);
+        else snprintf(line, sizeof(line), "DELETE %d %d", owner, pid);
+        parse_batch_item(line, &items[i]);
+    }
+    int m = ops < 2000 ? ops : 2000; // Jalur per item mahal: diukur pada sebagian item
+    BatchItem *single = (BatchItem*)malloc(sizeof(BatchItem) * m);
+    BatchItem *batched = (BatchItem*)malloc(sizeof(BatchItem) * ops);
+    memcpy(single, items, sizeof(BatchItem) * m);
+    memcpy(batched, items, sizeof(BatchItem) * m);
+    AppState app;
+    long len_a, len_b;
+
+    seed_batch_store(posts);
+    load_batch_store(&app);
+    double t = now_seconds();
+    apply_batch_individually(&app, single, m);
+    double single_time = now_seconds() - t;
+    int single_comments = app.comment_count;
+    free_all(&app);
+    FILE *file = fopen("posts.txt", "r");
+    fseek(file, 0, SEEK_END);
+    char *posts_single = read_whole_file(file, &len_a);
+    fclose(file);
+
+    seed_batch_store(posts);
+    load_batch_store(&app);
+    apply_batch(&app, batched, m);
+    bool ok = app.comment_count == single_comments;
+    free_all(&app);
+    file = fopen("posts.txt", "r");
+    fseek(file, 0, SEEK_END);
+    char *posts_batched = read_whole_file(file, &len_b);
+    fclose(file);
+    ok &= len_a == len_b && memcmp(posts_single, posts_batched, len_a) == 0;
+    for (int i = 0; i < m; i++) ok &= single[i].result == batched[i].result;
+
+    seed_batch_store(posts);
+    load_batch_store(&app);
+    memcpy(batched, items, sizeof(BatchItem) * ops);
+    t = now_seconds();
+    int applied = apply_batch(&app, batched, ops);
+    double batch_time = now_seconds() - t;
+    free_all(&app);
+
+    double single_rate = m / single_time, batch_rate = ops / batch_time;
+    printf("posts=%d item=%d\n", posts, ops);
+    printf("  satu per satu : %10.0f item/detik (diukur pada %d item)\n", single_rate, m);
+    printf("  apply_batch   : %10.0f item/detik (%d OK, %.3f ms total)\n", batch_rate, applied, batch_time * 1e3);
+    printf("  percepatan    : %10.0fx\n", batch_rate / single_rate);
+    printf("  hasil sama    : %s\n", ok ? "OK" : "GAGAL");
+    free(posts_single);
+    free(posts_batched);
+    free(items);
+    free(single);
+    free(batched);
+    if (chdir("..") != 0) return 1;
+    return ok ? 0 : 1;
+}
+#endif
+
+// [Tools] Pecah satu baris CSV (in-place). Mendukung field ber-quote dan "" sebagai escape
+int parse_csv_line(char *line, char **fields, int max_fields) {
+    int n = 0;
+    char *src = line, *dst = line;
+    while (n < max_fields) {
+        fields[n++] = dst;
+        if (*src == '"') {
+            src++;
+            while (*src) {
+                if (*src == '"' && src[1] == '"') { *dst++ = '"'; src += 2; }
+                else if (*src == '"') { src++; break; }
+                else *dst++ = *src++;
             }
-            p = p->next;
         }
-        if (!found) printf("Tidak ada post dari user ini.\n");
-    } else if (opsi == 2) {
-        search_post_by_id(app);
-    } else {
-        printf("Pilihan tidak valid.\n");
+        while (*src && *src != ',') *dst++ = *src++;
+        if (*src != ',') { *dst = '\0'; return n; }
+        src++;
+        *dst++ = '\0';
     }
+    return -1; // Terlalu banyak kolom
 }
 
-// [Menu] Menu user setelah login
-void user_menu(AppState *app); // Function prototype
+// [Tools] Cek field angka bulat
+bool is_int_field(const char *s) {
+    if (*s == '-') s++;
+    if (!*s) return false;
+    for (; *s; s++)
+        if (*s < '0' || *s > '9') return false;
+    return true;
+}
 
-// [Menu] Menu utama aplikasi
-void main_menu(AppState *app) {
-    int choice;
-    do {
-        printf("\n=====================================================\n");
-        printf("                SELAMAT DATANG DI INSTAGRAM          \n");
-        printf("=====================================================\n");
-        printf("  1. Sign Up\n");
-        printf("  2. Log In\n");
-        printf("  3. Exit\n");
-        printf("-----------------------------------------------------\n");
-        printf("Pilih menu (1-3): ");
-        scanf("%d", &choice);
-        printf("=====================================================\n");
-        switch (choice) {
-            case 1: signup(app); break;
-            case 2:
-                app->current_user_id = login(app);
-                if (app->current_user_id != -1) user_menu(app);
-                break;
-            case 3: 
-                printf("\nTerima kasih telah menggunakan aplikasi!\n\n");
-                exit(0);
-            default: printf(">> Pilihan tidak valid!\n");
-        }
-    } while (1);
+// [Tools] Cek field teks bisa disimpan di format file (tanpa '|' dan muat di MAX_STRING)
+bool is_text_field(const char *s) {
+    return *s && strlen(s) < MAX_STRING && !strchr(s, '|');
 }
 
-// [Menu] Menu user setelah login
-void user_menu(AppState *app) {
-    int choice;
-    do {
-        printf("\n=====================================================\n");
-        printf("                    USER MENU                        \n");
-        printf("=====================================================\n");
-        printf("  1.  Create Post\n");
-        printf("  2.  View Posts\n");
-        printf("  3.  Like Post\n");
-        printf("  4.  Unlike Post\n");
-        printf("  5.  Comment Post\n");
-        printf("  6.  Delete Post\n");
-        printf("  7.  Edit Post\n");
-        printf("  8.  Search Post\n");
-        printf("  9.  View Posts by Likes\n");
-        printf(" 10.  Undo Delete Post\n");
-        printf(" 11.  Show Notifications\n");
-        printf(" 12.  Log Out\n");
-        printf("-----------------------------------------------------\n");
-        printf("Pilih menu (1-12): ");
-        scanf("%d", &choice);
-        printf("=====================================================\n");
-        switch (choice) {
-            case 1: create_post(app); break;
-            case 2: view_posts(app); break;
-            case 3: like_post(app); break;
-            case 4: unlike_post(app); break;
-            case 5: comment_post(app); break;
-            case 6: delete_post(app); break;
-            case 7: edit_post(app); break;
-            case 8: search_post(app); break;
-            case 9: sort_and_show_posts_by_likes(app); break;
-            case 10: undo_delete_post(app); break;
-            case 11: showNotifications(app); break;
-            case 12: return;
-            default: printf(">> Pilihan tidak valid!\n");
-        }
-    } while (1);
+// Baris store yang sudah diformat, menunggu di-merge berdasarkan ID
+typedef struct {
+    char *text; // Baris-baris store, dipisah '\0'
+    int len, cap;
+    unsigned *keys; // int_key(ID)
+    int *offsets; // Awal baris di text
+    int count, capacity;
+} StoreRows;
+
+// [Tools] Tambahkan satu baris store dengan ID-nya
+void store_rows_add(StoreRows *rows, int id, const char *line) {
+    if (rows->count == rows->capacity) {
+        rows->capacity = rows->capacity ? rows->capacity * 2 : 1024;
+        rows->keys = (unsigned*)realloc(rows->keys, sizeof(unsigned) * rows->capacity);
+        rows->offsets = (int*)realloc(rows->offsets, sizeof(int) * rows->capacity);
+    }
+    rows->keys[rows->count] = int_key(id);
+    rows->offsets[rows->count++] = rows->len;
+    append_buf(&rows->text, &rows->len, &rows->cap, line);
+    rows->len++; // '\0' dari append_buf jadi pemisah baris
 }
 
-void bubble_sort_posts_by_id(Post **arr, int n) {
-    for (int i = 0; i < n-1; i++)
-        for (int j = 0; j < n-i-1; j++)
-            if (arr[j]->id > arr[j+1]->id) {
-                Post *tmp = arr[j];
-                arr[j] = arr[j+1];
-                arr[j+1] = tmp;
-            }
+void free_store_rows(StoreRows *rows) {
+    free(rows->text);
+    free(rows->keys);
+    free(rows->offsets);
 }
 
-void quick_sort_posts(Post **arr, int left, int right) {
-    if (left >= right) return;
-    int i = left, j = right;
-    int pivot = arr[(left + right) / 2]->likes;
-    while (i <= j) {
-        while (arr[i]->likes > pivot) i++;
-        while (arr[j]->likes < pivot) j--;
-        if (i <= j) {
-            Post *tmp = arr[i];
-            arr[i] = arr[j];
-            arr[j] = tmp;
-            i++; j--;
+// [Tools] Import dump CSV (users/posts/comments) ke file store, lalu bangun index.
+// Baris CSV diurutkan berdasarkan ID (radix sort) lalu di-merge dengan isi store lama sehingga
+// file hasilnya terurut ID. ID yang sudah ada di store atau muncul dua kali di CSV ditolak
+int import_csv(const char *kind, const char *path) {
+    const char *store, *tmp_store;
+    int columns;
+    if (strcmp(kind, "users") == 0) { store = "users.txt"; tmp_store = "users.txt.tmp"; columns = 4; }
+    else if (strcmp(kind, "posts") == 0) { store = "posts.txt"; tmp_store = "posts.txt.tmp"; columns = 5; }
+    else if (strcmp(kind, "comments") == 0) { store = "comments.txt"; tmp_store = "comments.txt.tmp"; columns = 4; }
+    else {
+        printf("Jenis import tidak dikenal: %s (users|posts|comments)\n", kind);
+        return 1;
+    }
+    FILE *in = fopen(path, "r");
+    if (!in) {
+        printf("Tidak bisa membuka %s\n", path);
+        return 1;
+    }
+
+    double start = now_seconds();
+    StoreRows old_rows = {0}, new_rows = {0};
+    char row[MAX_STRING * 4 + 64];
+    AppState app = {0};
+    if (kind[0] == 'u') {
+        load_users(&app);
+        for (User *u = app.users; u; u = u->next) {
+            snprintf(row, sizeof(row), "%d|%s|%s|%s\n", u->id, u->username, u->email, u->password);
+            store_rows_add(&old_rows, u->id, row);
+        }
+    } else if (kind[0] == 'p') {
+        load_posts(&app);
+        for (Post *p = app.posts; p; p = p->next) {
+            snprintf(row, sizeof(row), "%d|%d|%s|%s|%d|%d\n", p->id, p->user_id, p->cold ? "" : p->content, p->media, p->likes, p->cold);
+            store_rows_add(&old_rows, p->id, row);
+        }
+    } else {
+        load_comments(&app);
+        for (Comment *c = app.comments; c; c = c->next) {
+            snprintf(row, sizeof(row), "%d|%d|%d|%s\n", c->id, c->post_id, c->user_id, c->text);
+            store_rows_add(&old_rows, c->id, row);
         }
     }
-    if (left < j) quick_sort_posts(arr, left, j);
-    if (i < right) quick_sort_posts(arr, i, right);
-}
+    int max_id = app.last_post_id;
+    free_all(&app);
+    memset(&app, 0, sizeof(AppState));
 
-// [Searching: Binary Search] Binary search array post by ID
-int binary_search_post(Post **arr, int n, int id) {
-    int left = 0, right = n - 1;
-    while (left <= right) {
-        int mid = left + (right - left) / 2;
-        if (arr[mid]->id == id) return mid;
-        if (arr[mid]->id < id) left = mid + 1;
-        else right = mid - 1;
+    char line[4096];
+    char *f[5];
+    long skipped = 0, line_no = 0;
+    while (fgets(line, sizeof(line), in)) {
+        line_no++;
+        line[strcspn(line, "\r\n")] = 0;
+        if (!line[0]) continue;
+        int n = parse_csv_line(line, f, 5);
+        if (line_no == 1 && n > 0 && !is_int_field(f[0])) continue; // Baris header
+        bool ok = n == columns && is_int_field(f[0]);
+        if (ok && columns == 4 && kind[0] == 'u')
+            ok = is_text_field(f[1]) && is_text_field(f[2]) && is_text_field(f[3]) && !strchr(f[3], ' ');
+        else if (ok && columns == 5)
+            ok = is_int_field(f[1]) && is_text_field(f[2]) && is_text_field(f[3]) && is_int_field(f[4]);
+        else if (ok)
+            ok = is_int_field(f[1]) && is_int_field(f[2]) && is_text_field(f[3]);
+        if (!ok) {
+            skipped++;
+            continue;
+        }
+        if (columns == 5)
+            snprintf(row, sizeof(row), "%s|%s|%s|%s|%s|0\n", f[0], f[1], f[2], f[3], f[4]);
+        else
+            snprintf(row, sizeof(row), "%s|%s|%s|%s\n", f[0], f[1], f[2], f[3]);
+        store_rows_add(&new_rows, atoi(f[0]), row);
     }
-    return -1;
-}
+    fclose(in);
+    radix_sort_pairs(old_rows.keys, old_rows.offsets, old_rows.count);
+    radix_sort_pairs(new_rows.keys, new_rows.offsets, new_rows.count); // Stabil: duplikat CSV pertama yang menang
 
-// Tambahkan struct BST untuk User
-/* Duplicate definition of UserBSTNode removed */
+    FILE *out = fopen(tmp_store, "w");
+    if (!out) {
+        printf("Tidak bisa menulis %s\n", tmp_store);
+        free_store_rows(&old_rows);
+        free_store_rows(&new_rows);
+        return 1;
+    }
+    setvbuf(out, NULL, _IOFBF, 1 << 20);
+    if (kind[0] == 'p') { // Header posts.txt butuh ID terbesar: baris terakhir salah satu sisi merge
+        if (old_rows.count && atoi(old_rows.text + old_rows.offsets[old_rows.count - 1]) > max_id)
+            max_id = atoi(old_rows.text + old_rows.offsets[old_rows.count - 1]);
+        if (new_rows.count && atoi(new_rows.text + new_rows.offsets[new_rows.count - 1]) > max_id)
+            max_id = atoi(new_rows.text + new_rows.offsets[new_rows.count - 1]);
+        fprintf(out, "#%d|%d\n", max_id, POSTS_FORMAT);
+    }
+    long imported = 0, duplicates = 0;
+    int dup_ids[10];
+    unsigned last_key = 0;
+    bool emitted = false;
+    int i = 0, j = 0;
+    while (i < old_rows.count || j < new_rows.count) {
+        if (j == new_rows.count || (i < old_rows.count && old_rows.keys[i] <= new_rows.keys[j])) {
+            fputs(old_rows.text + old_rows.offsets[i], out); // Baris lama selalu dipertahankan
+            last_key = old_rows.keys[i++];
+        } else if (emitted && new_rows.keys[j] == last_key) {
+            if (duplicates < 10) dup_ids[duplicates] = atoi(new_rows.text + new_rows.offsets[j]);
+            duplicates++;
+            j++;
+            continue;
+        } else {
+            fputs(new_rows.text + new_rows.offsets[j], out);
+            last_key = new_rows.keys[j++];
+            imported++;
+        }
+        emitted = true;
+    }
+    fclose(out);
+    free_store_rows(&old_rows);
+    free_store_rows(&new_rows);
+    remove(store);
+    if (rename(tmp_store, store) != 0) {
+        printf("Gagal mengganti %s\n", store);
+        return 1;
+    }
+    double import_time = now_seconds() - start;
 
-// [BST] Insert user ke BST User
-UserBSTNode* insert_user_bst(UserBSTNode *root, User *user) {
-    if (!root) {
-        UserBSTNode *node = (UserBSTNode*)malloc(sizeof(UserBSTNode));
-        node->user = user;
-        node->left = node->right = NULL;
-        return node;
+    // Muat ulang store dan bangun index seimbang untuk verifikasi
+    start = now_seconds();
+    load_users(&app);
+    load_posts(&app);
+    load_comments(&app);
+    double load_time = now_seconds() - start;
+    start = now_seconds();
+    bulk_build_indexes(&app);
+    PostBSTNode *postBST = bulk_build_post_bst(app.posts);
+    double index_time = now_seconds() - start;
+
+    printf("Import %s: %ld baris masuk, %ld dilewati, %ld duplikat ID ditolak (%.3fs)\n",
+           kind, imported, skipped, duplicates, import_time);
+    if (duplicates > 0) {
+        printf("ID duplikat:");
+        for (int k = 0; k < duplicates && k < 10; k++) printf(" %d", dup_ids[k]);
+        printf("%s\n", duplicates > 10 ? " ..." : "");
     }
-    if (strcmp(user->username, root->user->username) < 0)
-        root->left = insert_user_bst(root->left, user);
-    else if (strcmp(user->username, root->user->username) > 0)
-        root->right = insert_user_bst(root->right, user);
-    return root;
+    printf("Store: %d users, %d posts, %d comments (load %.3fs, index %.3fs)\n",
+           app.user_count, app.post_count, app.comment_count, load_time, index_time);
+    free_post_bst(postBST);
+    free_all(&app);
+    return 0;
 }
 
-// [BST] Cari user pada BST User berdasarkan username
-User* search_user_bst(UserBSTNode *root, const char *username) {
-    if (!root) return NULL;
-    int cmp = strcmp(username, root->user->username);
-    if (cmp == 0) return root->user;
-    if (cmp < 0) return search_user_bst(root->left, username);
-    else return search_user_bst(root->right, username);
+// [Tools] Urutkan comment berdasarkan post_id lalu ID
+int cmp_comment_ptr_post(const void *a, const void *b) {
+    const Comment *x = *(Comment* const*)a, *y = *(Comment* const*)b;
+    if (x->post_id != y->post_id) return (x->post_id > y->post_id) - (x->post_id < y->post_id);
+    return (x->id > y->id) - (x->id < y->id);
 }
 
-// Tambahkan struct BST untuk Comment
+// [Tools] Tambahkan teks ke buffer yang bisa tumbuh
+void append_buf(char **buf, int *len, int *cap, const char *text) {
+    int n = strlen(text);
+    if (*len + n + 1 > *cap) {
+        while (*len + n + 1 > *cap) *cap = *cap ? *cap * 2 : 1024;
+        *buf = (char*)realloc(*buf, *cap);
+    }
+    memcpy(*buf + *len, text, n + 1);
+    *len += n;
+}
 
-// [BST] Insert comment ke BST Comment
-CommentBSTNode* insert_comment_bst(CommentBSTNode *root, Comment *comment) {
-    if (!root) {
-        CommentBSTNode *node = (CommentBSTNode*)malloc(sizeof(CommentBSTNode));
-        node->comment = comment;
-        node->left = node->right = NULL;
-        return node;
+// [Tools] Tulis cold.tags untuk satu blok: satu baris "post_id|tag" per tag unik (caption + comment)
+void write_cold_tags(FILE *out, int post_id, const char *raw) {
+    char tag[TAG_MAX + 2], key[TAG_MAX + 4];
+    char *seen = NULL; // " tag1 tag2 ... "
+    int len = 0, cap = 0;
+    append_buf(&seen, &len, &cap, " ");
+    const char *cursor = raw;
+    while (next_tag_token(&cursor, raw, tag)) {
+        snprintf(key, sizeof(key), " %s ", tag);
+        if (strstr(seen, key)) continue;
+        append_buf(&seen, &len, &cap, key + 1);
+        fprintf(out, "%d|%s\n", post_id, tag);
     }
-    if (comment->id < root->comment->id)
-        root->left = insert_comment_bst(root->left, comment);
-    else if (comment->id > root->comment->id)
-        root->right = insert_comment_bst(root->right, comment);
-    return root;
+    free(seen);
 }
 
-// [BST] Cari comment pada BST Comment berdasarkan ID
-Comment* search_comment_bst(CommentBSTNode *root, int id) {
-    if (!root) return NULL;
-    if (id == root->comment->id) return root->comment;
-    if (id < root->comment->id) return search_comment_bst(root->left, id);
-    else return search_comment_bst(root->right, id);
+// [Tools] Kompres satu grup post ke segment cold dan tulis entry index-nya. Return ukuran terkompresi
+int write_cold_group(FILE *seg, FILE *idx, ColdIndexEntry *group, int count, const char *raw, int raw_len, long offset) {
+    unsigned char *packed = (unsigned char*)malloc(raw_len + raw_len / 128 + 1);
+    int clen = cold_compress((const unsigned char*)raw, raw_len, packed);
+    fwrite(packed, 1, clen, seg);
+    free(packed);
+    for (int i = 0; i < count; i++)
+        fprintf(idx, "%d|%ld|%d|%d|%d|%d\n", group[i].post_id, offset, clen, raw_len, group[i].start, group[i].len);
+    return clen;
 }
 
-// [Heap berdasarkan jumlah post user
-typedef struct {
-    User **arr;
-    int size;
-    int capacity;
-} UserHeap;
+// [Tools] Pindahkan caption & comment post lama (selain keep_recent post terbaru) ke segment cold.
+// Jalankan saat aplikasi tidak sedang dipakai; segment lama ditulis ulang utuh.
+int archive_cold_data(int keep_recent) {
+    AppState app = {0};
+    load_posts(&app);
+    load_comments(&app);
+    load_cold_index(&app);
+    int threshold = app.last_post_id - keep_recent;
 
-// Implementasi heapify dan build heap mirip PostHeap, tapi berdasarkan jumlah post user
+    Post **posts = (Post**)malloc(sizeof(Post*) * (app.post_count + 1));
+    int n = 0;
+    for (Post *p = app.posts; p; p = p->next) posts[n++] = p;
+    bulk_sort_ptrs((void**)posts, n, cmp_post_ptr_id);
+    Comment **hot = (Comment**)malloc(sizeof(Comment*) * (app.comment_count + 1));
+    char *archived = (char*)calloc(app.comment_count + 1, 1);
+    int m = 0;
+    for (Comment *c = app.comments; c; c = c->next) hot[m++] = c;
+    qsort(hot, m, sizeof(Comment*), cmp_comment_ptr_post);
 
-// [Linked List] Free semua alokasi memori
-void free_all(AppState *app) {
-    // Free users
-    User *u = app->users;
-    while (u) {
-        User *tmp = u;
-        u = u->next;
-        free(tmp);
+    FILE *seg = fopen("cold.seg.tmp", "wb");
+    FILE *idx = fopen("cold.idx.tmp", "w");
+    FILE *tags = fopen("cold.tags.tmp", "w");
+    if (!seg || !idx || !tags) {
+        printf("Tidak bisa menulis segment cold.\n");
+        if (seg) fclose(seg);
+        if (idx) fclose(idx);
+        if (tags) fclose(tags);
+        free(posts); free(hot); free(archived);
+        free_all(&app);
+        return 1;
     }
-    // Free posts
-    Post *p = app->posts;
-    while (p) {
-        Post *tmp = p;
-        p = p->next;
-        free(tmp);
+    fprintf(idx, "#%d\n", app.last_comment_id);
+
+    // Post dikumpulkan ke raw sampai ~COLD_GROUP_BYTES, lalu dikompres bersama sebagai satu blok
+    ColdIndexEntry *group = (ColdIndexEntry*)malloc(sizeof(ColdIndexEntry) * (n + 1));
+    char *raw = NULL, line[MAX_STRING * 2];
+    int raw_len = 0, raw_cap = 0, grouped = 0;
+    long offset = 0, raw_total = 0;
+    int cold_posts = 0, moved_comments = 0, ci = 0;
+    for (int i = 0; i < n; i++) {
+        Post *p = posts[i];
+        while (ci < m && hot[ci]->post_id < p->id) ci++;
+        if (p->id > threshold && !p->cold) continue;
+
+        int start = raw_len;
+        append_buf(&raw, &raw_len, &raw_cap, post_caption(&app, p));
+        append_buf(&raw, &raw_len, &raw_cap, "\n");
+        ColdBlock *b = p->cold ? load_cold_block(&app, p->id) : NULL;
+        for (int k = 0; b && k < b->comment_count; k++) {
+            snprintf(line, sizeof(line), "%d|%d|%s\n", b->comments[k].id, b->comments[k].user_id, b->comments[k].text);
+            append_buf(&raw, &raw_len, &raw_cap, line);
+        }
+        for (; ci < m && hot[ci]->post_id == p->id; ci++) {
+            snprintf(line, sizeof(line), "%d|%d|%s\n", hot[ci]->id, hot[ci]->user_id, hot[ci]->text);
+            append_buf(&raw, &raw_len, &raw_cap, line);
+            archived[ci] = 1;
+            moved_comments++;
+        }
+
+        group[grouped].post_id = p->id;
+        group[grouped].start = start;
+        group[grouped].len = raw_len - start;
+        grouped++;
+        write_cold_tags(tags, p->id, raw + start);
+        p->cold = true;
+        drop_post_caption(p); // Post cold hanya menyimpan metadata
+        cold_posts++;
+        if (raw_len >= COLD_GROUP_BYTES) {
+            offset += write_cold_group(seg, idx, group, grouped, raw, raw_len, offset);
+            raw_total += raw_len;
+            raw_len = grouped = 0;
+        }
     }
-    // Free comments
-    Comment *c = app->comments;
-    while (c) {
-        Comment *tmp = c;
-        c = c->next;
-        free(tmp);
+    if (grouped) {
+        offset += write_cold_group(seg, idx, group, grouped, raw, raw_len, offset);
+        raw_total += raw_len;
     }
-    // Free undo stack
-    UndoNode *un = app->undoTop;
-    while (un) {
-        UndoNode *tmp = un;
-        un = un->next;
-        free(tmp);
+    fclose(seg);
+    fclose(idx);
+    fclose(tags);
+    free(raw);
+    free(group);
+    free_cold_storage(&app); // Tutup cold.seg lama sebelum diganti
+
+    remove("cold.seg");
+    remove("cold.idx");
+    remove("cold.tags");
+    if (rename("cold.seg.tmp", "cold.seg") != 0 || rename("cold.idx.tmp", "cold.idx") != 0 ||
+        rename("cold.tags.tmp", "cold.tags") != 0) {
+        printf("Gagal mengganti segment cold.\n");
+        free(posts); free(hot); free(archived);
+        free_all(&app);
+        return 1;
     }
-    // Free notifications queue
-    NotifNode *nn = app->notifFront;
-    while (nn) {
-        NotifNode *tmp = nn;
-        nn = nn->next;
-        free(tmp);
+    save_posts(&app);
+    FILE *file = fopen("comments.txt", "w");
+    for (int k = 0; file && k < m; k++)
+        if (!archived[k])
+            fprintf(file, "%d|%d|%d|%s\n", hot[k]->id, hot[k]->post_id, hot[k]->user_id, hot[k]->text);
+    if (file) fclose(file);
+
+    printf("Archive: %d post cold (%d comment baru dipindah), %ld byte -> %ld byte terkompresi\n",
+           cold_posts, moved_comments, raw_total, offset);
+    free(posts);
+    free(hot);
+    free(archived);
+    free_all(&app);
+    return 0;
+}
+
+// [Tools] Jalankan mode non-interaktif berdasarkan argumen command line
+int run_tool(int argc, char *argv[]) {
+    if (strcmp(argv[1], "--bench-likes") == 0) {
+        int threads = argc > 2 ? atoi(argv[2]) : 8;
+        int users = argc > 3 ? atoi(argv[3]) : 0; // 0 = sapu 2000/20000/200000 liker
+        int rounds = argc > 4 ? atoi(argv[4]) : 3;
+        if (threads < 1 || users < 0 || rounds < 1) {
+            printf("Usage: %s --bench-likes [threads] [users] [rounds]\n", argv[0]);
+            return 1;
+        }
+        return bench_likes(threads, users, rounds);
     }
+    if (strcmp(argv[1], "--memory-report") == 0) {
+        // Muat store seperti saat startup, lalu laporkan pemakaian memori
+        AppState app = {0};
+        load_users(&app);
+        load_posts(&app);
+        load_comments(&app);
+        load_cold_index(&app);
+        bulk_build_indexes(&app);
+        show_memory_report(&app);
+        free_all(&app);
+        return 0;
+    }
+#ifndef _WIN32
+    if (strcmp(argv[1], "--shard-server") == 0 && argc > 4) {
+        int index = atoi(argv[2]), count = atoi(argv[3]);
+        if (count < 1 || count > SHARD_MAX || index < 0 || index >= count) {
+            printf("Usage: %s --shard-server index(0-%d) count(1-%d) dir\n", argv[0], SHARD_MAX - 1, SHARD_MAX);
+            return 1;
+        }
+        return shard_server(index, count, argv[4]);
+    }
+    if (strcmp(argv[1], "--router") == 0) {
+        int count = argc > 2 ? atoi(argv[2]) : 4;
+        if (count < 1 || count > SHARD_MAX) {
+            printf("Usage: %s --router [shards 1-%d] [base_dir]\n", argv[0], SHARD_MAX);
+            return 1;
+        }
+        return run_router(count, argc > 3 ? argv[3] : "shards");
+    }
+    if (strcmp(argv[1], "--replica") == 0 && argc > 3)
+        return replica_server(argv[2], argv[3]);
+    if (strcmp(argv[1], "--bench-replication") == 0) {
+        int replicas = argc > 2 ? atoi(argv[2]) : 3;
+        int ops = argc > 3 ? atoi(argv[3]) : 5000;
+        if (replicas < 1 || replicas > SHARD_MAX || ops < 1) {
+            printf("Usage: %s --bench-replication [replicas] [ops]\n", argv[0]);
+            return 1;
+        }
+        return bench_replication(replicas, ops);
+    }
+    if (strcmp(argv[1], "--bench-shards") == 0) {
+        int max_shards = argc > 2 ? atoi(argv[2]) : 8;
+        int ops = argc > 3 ? atoi(argv[3]) : 2000;
+        int clients = argc > 4 ? atoi(argv[4]) : 16;
+        if (max_shards < 1 || max_shards > SHARD_MAX || ops < 1 || clients < 1 || clients > SHARD_MAX * 4) {
+            printf("Usage: %s --bench-shards [max_shards] [ops_per_client] [clients]\n", argv[0]);
+            return 1;
+        }
+        return bench_shards(max_shards, 2000, clients, ops);
+    }
+#endif
+    if (strcmp(argv[1], "--bench-render") == 0) {
+        int n = argc > 2 ? atoi(argv[2]) : 2000;
+        int views = argc > 3 ? atoi(argv[3]) : 50;
+        long cap_kb = argc > 4 ? atol(argv[4]) : RENDER_CACHE_BYTES / 1024;
+        if (n < 1 || views < 1 || cap_kb < 0) {
+            printf("Usage: %s --bench-render [posts] [views] [cap_kb]\n", argv[0]);
+            return 1;
+        }
+        return bench_render(n, views, (size_t)cap_kb * 1024);
+    }
+    if (strcmp(argv[1], "--check-trending") == 0) {
+        int occurrences = argc > 2 ? atoi(argv[2]) : 500000;
+        int distinct = argc > 3 ? atoi(argv[3]) : 20000;
+        if (occurrences < 1 || distinct < 1) {
+            printf("Usage: %s --check-trending [occurrences] [distinct_tags]\n", argv[0]);
+            return 1;
+        }
+        return check_trending(occurrences, distinct);
+    }
+    if (strcmp(argv[1], "--batch") == 0 && argc > 2)
+        return run_batch(argv[2]);
+#ifndef _WIN32
+    if (strcmp(argv[1], "--bench-batch") == 0) {
+        int posts = argc > 2 ? atoi(argv[2]) : 20000;
+        int ops = argc > 3 ? atoi(argv[3]) : 100000;
+        if (posts < 1 || ops < 1) {
+            printf("Usage: %s --bench-batch [posts] [items]\n", argv[0]);
+            return 1;
+        }
+        return bench_batch(posts, ops);
+    }
+#endif
+    if (strcmp(argv[1], "--bench-sort") == 0) {
+        int n = argc > 2 ? atoi(argv[2]) : 100000;
+        int queries = argc > 3 ? atoi(argv[3]) : 1000000;
+        if (n < 1 || queries < 1) {
+            printf("Usage: %s --bench-sort [n] [queries]\n", argv[0]);
+            return 1;
+        }
+        return bench_sort(n, queries);
+    }
+    if (strcmp(argv[1], "--import-csv") == 0) {
+        if (argc < 4) {
+            printf("Usage: %s --import-csv <users|posts|comments> <file.csv>\n", argv[0]);
+            return 1;
+        }
+        return import_csv(argv[2], argv[3]);
+    }
+    if (strcmp(argv[1], "--export") == 0) {
+        ExportFilter filter = { 0, 0, 2147483647, -2147483647 };
+        bool ok = argc >= 4;
+        for (int i = 4; ok && i < argc; i += 2) {
+            if (i + 1 >= argc) ok = false;
+            else if (strcmp(argv[i], "--author") == 0) filter.author = atoi(argv[i+1]);
+            else if (strcmp(argv[i], "--min-id") == 0) filter.min_id = atoi(argv[i+1]);
+            else if (strcmp(argv[i], "--max-id") == 0) filter.max_id = atoi(argv[i+1]);
+            else if (strcmp(argv[i], "--min-likes") == 0) filter.min_likes = atoi(argv[i+1]);
+            else ok = false;
+        }
+        if (!ok) {
+            fprintf(stderr, "Usage: %s --export <jsonl|csv> <file|-> [--author ID] [--min-id N] [--max-id N] [--min-likes N]\n", argv[0]);
+            return 1;
+        }
+        return export_posts(argv[2], argv[3], filter);
+    }
+    if (strcmp(argv[1], "--archive-cold") == 0) {
+        int keep_recent = argc > 2 ? atoi(argv[2]) : 1000;
+        if (keep_recent < 0) {
+            printf("Usage: %s --archive-cold [jumlah post terbaru yang tetap hot]\n", argv[0]);
+            return 1;
+        }
+        return archive_cold_data(keep_recent);
+    }
+    printf("Unknown option: %s\n", argv[1]);
+    return 1;
 }
 
 // [Main] Entry point aplikasi
-int main() {
+int main(int argc, char *argv[]) {
+    // --render-cache-kb N: jalankan aplikasi dengan batas cache render N KB (0 = nonaktif)
+    bool cache_option = argc == 3 && strcmp(argv[1], "--render-cache-kb") == 0;
+    if (argc > 1 && !cache_option) return run_tool(argc, argv);
+
     AppState app = {0};
     app.users = NULL;
     app.posts = NULL;
     app.comments = NULL;
     app.undoTop = NULL;
     app.notifFront = app.notifRear = NULL;
+    app.render_cache_cap = RENDER_CACHE_BYTES;
     load_users(&app);
     load_posts(&app);
     load_comments(&app);
+    load_cold_index(&app);
+    if (cache_option) app.render_cache_cap = (size_t)atol(argv[2]) * 1024;
 
-    User *u = app.users;
-    app.userBST = NULL;
-    while (u) {
-        app.userBST = insert_user_bst(app.userBST, u);
-        u = u->next;
-    }
-
-    Comment *c = app.comments;
-    app.commentBST = NULL;
-    while (c) {
-        app.commentBST = insert_comment_bst(app.commentBST, c);
-        c = c->next;
-    }
+    bulk_build_indexes(&app);
 
     main_menu(&app);
     free_all(&app);